@@ -0,0 +1,189 @@
+#include "bench_common.h"
+#include "core/pe_image.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace xordll;
+using namespace xordll::bench;
+
+namespace {
+
+constexpr uint32_t HeaderSize = 0x400;
+constexpr uint32_t NtHeaderOffset = 0x40;
+constexpr uint16_t OptionalHeaderSize = 240;
+constexpr size_t SectionHeaderSize = 40;
+
+void Put16(std::vector<uint8_t>& buffer, size_t offset, uint16_t value) {
+    std::memcpy(buffer.data() + offset, &value, sizeof(value));
+}
+
+void Put32(std::vector<uint8_t>& buffer, size_t offset, uint32_t value) {
+    std::memcpy(buffer.data() + offset, &value, sizeof(value));
+}
+
+// Minimal PE32+ DLL: DOS stub, NT headers and a section table in the given
+// (possibly unsorted) order, padded or truncated to fileSize.
+std::vector<uint8_t> MakeImage(const std::vector<pe::Section>& sections, size_t fileSize) {
+    size_t fileHeader = NtHeaderOffset + 4;
+    size_t optional = fileHeader + 20;
+    size_t sectionTable = optional + OptionalHeaderSize;
+
+    std::vector<uint8_t> buffer(std::max(fileSize, sectionTable + sections.size() * SectionHeaderSize));
+    Put16(buffer, 0, pe::DosSignature);
+    Put32(buffer, 0x3C, NtHeaderOffset);
+    Put32(buffer, NtHeaderOffset, pe::NtSignature);
+    Put16(buffer, fileHeader, pe::MachineAmd64);
+    Put16(buffer, fileHeader + 2, static_cast<uint16_t>(sections.size()));
+    Put16(buffer, fileHeader + 16, OptionalHeaderSize);
+    Put16(buffer, fileHeader + 18, pe::FileDll);
+    Put16(buffer, optional, pe::OptionalMagic64);
+    Put32(buffer, optional + 56, 0x100000);
+    Put32(buffer, optional + 60, HeaderSize);
+    Put32(buffer, optional + 108, pe::DirectoryCount);
+
+    for (size_t i = 0; i < sections.size(); i++) {
+        size_t header = sectionTable + i * SectionHeaderSize;
+        Put32(buffer, header + 8, sections[i].virtualSize);
+        Put32(buffer, header + 12, sections[i].virtualAddress);
+        Put32(buffer, header + 16, sections[i].rawDataSize);
+        Put32(buffer, header + 20, sections[i].rawDataOffset);
+    }
+    return buffer;
+}
+
+// The linear section walk PeImage used before the sorted range tables.
+bool ReferenceLocate(const std::vector<pe::Section>& sections, size_t fileSize, uint32_t rva, uint32_t& offset,
+    size_t& available) {
+    if (rva < HeaderSize) {
+        if (rva >= fileSize) {
+            return false;
+        }
+        offset = rva;
+        available = std::min<size_t>(HeaderSize, fileSize) - rva;
+        return true;
+    }
+
+    for (const auto& section : sections) {
+        if (rva < section.virtualAddress || rva - section.virtualAddress >= section.rawDataSize) {
+            continue;
+        }
+        uint32_t delta = rva - section.virtualAddress;
+        uint64_t fileOffset = static_cast<uint64_t>(section.rawDataOffset) + delta;
+        if (fileOffset >= fileSize) {
+            return false;
+        }
+        offset = static_cast<uint32_t>(fileOffset);
+        available = std::min<size_t>(section.rawDataSize - delta, fileSize - offset);
+        return true;
+    }
+    return false;
+}
+
+std::vector<pe::Section> MakeSections(int count, std::mt19937& rng, uint32_t& imageEnd, uint32_t& fileEnd) {
+    std::vector<pe::Section> sections;
+    uint32_t virtualAddress = 0x1000;
+    uint32_t rawOffset = HeaderSize;
+
+    for (int i = 0; i < count; i++) {
+        pe::Section section{};
+        section.virtualAddress = virtualAddress;
+        section.virtualSize = 1 + rng() % 0x3000;
+        section.rawDataSize = rng() % 5 == 0 ? 0 : (section.virtualSize + 0x1FF) & ~0x1FFu;
+        section.rawDataOffset = rawOffset;
+        rawOffset += section.rawDataSize;
+        virtualAddress += (section.virtualSize + 0xFFF) & ~0xFFFu;
+        sections.push_back(section);
+    }
+
+    imageEnd = virtualAddress;
+    fileEnd = rawOffset;
+    return sections;
+}
+
+}
+
+int main(int argc, char** argv) {
+    bool checkOnly = IsCheckOnly(argc, argv);
+    std::mt19937 rng(0xADD2);
+
+    int images = checkOnly ? 500 : 3000;
+    for (int iteration = 0; iteration < images; iteration++) {
+        int count = 1 + rng() % 96;
+        uint32_t imageEnd = 0;
+        uint32_t fileEnd = 0;
+        std::vector<pe::Section> sections = MakeSections(count, rng, imageEnd, fileEnd);
+        std::shuffle(sections.begin(), sections.end(), rng);
+
+        size_t minimumSize = HeaderSize + count * SectionHeaderSize + 0x200;
+        size_t truncate = rng() % 2 ? rng() % 0x800 : 0;
+        size_t fileSize = fileEnd > truncate + minimumSize ? fileEnd - truncate : fileEnd;
+
+        std::vector<uint8_t> buffer = MakeImage(sections, fileSize);
+        PeImage image(buffer.data(), buffer.size());
+        XORDLL_BENCH_EXPECT(image.IsValid(), "iteration %d", iteration);
+
+        for (int query = 0; query < 2000; query++) {
+            uint32_t rva = rng() % (imageEnd + 0x2000);
+            uint32_t expectedOffset = 0;
+            size_t expectedAvailable = 0;
+            bool expected = ReferenceLocate(sections, buffer.size(), rva, expectedOffset, expectedAvailable);
+
+            size_t available = 0;
+            const uint8_t* span = image.RvaToSpan(rva, available);
+            XORDLL_BENCH_EXPECT((span != nullptr) == expected, "iteration %d, rva 0x%X", iteration, rva);
+            if (!expected) {
+                continue;
+            }
+
+            uint32_t offset = static_cast<uint32_t>(span - buffer.data());
+            XORDLL_BENCH_EXPECT(offset == expectedOffset && available == expectedAvailable,
+                "iteration %d, rva 0x%X: offset 0x%X/0x%X, available %zu/%zu", iteration, rva, offset, expectedOffset,
+                available, expectedAvailable);
+
+            if (offset >= HeaderSize) {
+                uint32_t roundTrip = 0;
+                XORDLL_BENCH_EXPECT(image.OffsetToRva(offset, roundTrip) && roundTrip == rva,
+                    "iteration %d, offset 0x%X", iteration, offset);
+            }
+        }
+    }
+
+    const int lookups = checkOnly ? 100000 : 10000000;
+    std::printf("%-9s %12s %12s\n", "sections", "table ns", "linear ns");
+    for (int count : { 1, 4, 8, 16, 32, 64, 96 }) {
+        std::vector<pe::Section> sections;
+        for (int i = 0; i < count; i++) {
+            pe::Section section{};
+            section.virtualAddress = 0x1000 * (i + 1);
+            section.virtualSize = 0x1000;
+            section.rawDataSize = 0x1000;
+            section.rawDataOffset = HeaderSize + 0x1000 * i;
+            sections.push_back(section);
+        }
+
+        std::vector<uint8_t> buffer = MakeImage(sections, HeaderSize + 0x1000 * count);
+        PeImage image(buffer.data(), buffer.size());
+        volatile size_t sink = 0;
+
+        auto rvaFor = [count](int query) {
+            return 0x1000 + static_cast<uint32_t>(query * 2654435761u) % (count * 0x1000);
+        };
+
+        double table = MeasureMs(1, [&] {
+            for (int query = 0; query < lookups; query++) {
+                uint32_t offset;
+                sink = sink + image.RvaToOffset(rvaFor(query), offset);
+            }
+        });
+        double linear = MeasureMs(1, [&] {
+            for (int query = 0; query < lookups; query++) {
+                uint32_t offset;
+                size_t available;
+                sink = sink + ReferenceLocate(sections, buffer.size(), rvaFor(query), offset, available);
+            }
+        });
+        std::printf("%-9d %12.2f %12.2f\n", count, table * 1e6 / lookups, linear * 1e6 / lookups);
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include "baseline_logger.h"
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+namespace xordll {
+namespace bench {
+
+namespace {
+
+const wchar_t* LevelToString(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug:   return L"DEBUG";
+        case LogLevel::Info:    return L"INFO";
+        case LogLevel::Warning: return L"WARNING";
+        case LogLevel::Error:   return L"ERROR";
+        default:                return L"UNKNOWN";
+    }
+}
+
+}
+
+bool BaselineLogger::Initialize(const std::wstring& logFilePath)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_initialized) {
+        return true;
+    }
+
+    m_logFile.open(std::string(logFilePath.begin(), logFilePath.end()), std::ios::app | std::ios::out);
+    if (!m_logFile.is_open()) {
+        return false;
+    }
+
+    m_logFile.seekp(0, std::ios::end);
+    m_currentFileSize = static_cast<size_t>(m_logFile.tellp());
+    m_initialized = true;
+    return true;
+}
+
+void BaselineLogger::Shutdown()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_initialized) {
+        return;
+    }
+
+    m_logFile << L"=== Logger shutdown ===" << std::endl;
+    m_logFile.close();
+    m_entries.clear();
+    m_initialized = false;
+}
+
+void BaselineLogger::Log(LogLevel level, const std::wstring& message)
+{
+    Entry entry(level, message);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.push_back(entry);
+    while (m_entries.size() > 1000) {
+        m_entries.erase(m_entries.begin());
+    }
+
+    if (m_initialized) {
+        WriteToFile(entry);
+    }
+}
+
+void BaselineLogger::WriteToFile(const Entry& entry)
+{
+    std::wstring formatted = FormatEntry(entry);
+    m_logFile << formatted << std::endl;
+    m_logFile.flush();
+
+    m_currentFileSize += (formatted.length() + 1) * sizeof(wchar_t);
+}
+
+std::wstring BaselineLogger::FormatEntry(const Entry& entry) const
+{
+    auto time = std::chrono::system_clock::to_time_t(entry.timestamp);
+    std::tm tm;
+    localtime_s(&tm, &time);
+
+    std::wstringstream ss;
+    ss << std::put_time(&tm, L"[%Y-%m-%d %H:%M:%S] ")
+       << L"[" << LevelToString(entry.level) << L"] "
+       << entry.message;
+
+    return ss.str();
+}
+
+}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "core/types.h"
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace xordll {
+namespace bench {
+
+// The logger's hot path as it was before the lock-free queue and writer thread:
+// every call formats through a wstringstream, appends to a capped vector and
+// writes plus flushes the file while holding one mutex. Kept only so
+// logger_bench can measure the current Logger against it on the same machine.
+class BaselineLogger {
+public:
+    struct Entry {
+        LogLevel level;
+        std::wstring message;
+        std::chrono::system_clock::time_point timestamp;
+
+        Entry(LogLevel lvl, const std::wstring& msg)
+            : level(lvl), message(msg), timestamp(std::chrono::system_clock::now()) {}
+    };
+
+    BaselineLogger() = default;
+    ~BaselineLogger() { Shutdown(); }
+
+    BaselineLogger(const BaselineLogger&) = delete;
+    BaselineLogger& operator=(const BaselineLogger&) = delete;
+
+    bool Initialize(const std::wstring& logFilePath);
+    void Shutdown();
+    void Log(LogLevel level, const std::wstring& message);
+
+private:
+    void WriteToFile(const Entry& entry);
+    std::wstring FormatEntry(const Entry& entry) const;
+
+    std::wofstream m_logFile;
+    size_t m_currentFileSize = 0;
+    std::vector<Entry> m_entries;
+    std::mutex m_mutex;
+    bool m_initialized = false;
+};
+
+}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace xordll {
+namespace bench {
+
+inline bool IsCheckOnly(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--check") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename Body>
+double MeasureMs(int repetitions, Body&& body) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; i++) {
+        body();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::milli>(elapsed).count() / repetitions;
+}
+
+#define XORDLL_BENCH_EXPECT(condition, ...) \
+    do { \
+        if (!(condition)) { \
+            std::fprintf(stderr, "FAILED: %s: ", #condition); \
+            std::fprintf(stderr, __VA_ARGS__); \
+            std::fprintf(stderr, "\n"); \
+            return 1; \
+        } \
+    } while (0)
+
+}
+}
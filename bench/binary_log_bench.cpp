@@ -0,0 +1,225 @@
+#include "bench_common.h"
+#include "utils/binary_log.h"
+#include <ctime>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace xordll::utils;
+using namespace xordll::bench;
+
+namespace {
+
+struct Message {
+    uint64_t timestampNs;
+    uint32_t threadId;
+    uint8_t level;
+    std::wstring text;
+};
+
+constexpr uint64_t StartNs = 1760000000000000000ULL;
+const char* const LevelNames[] = { "DEBUG", "INFO", "WARNING", "ERROR" };
+
+// Eight threads logging numbered lines back to back, like logger_bench.
+std::vector<Message> MakeBurst(std::mt19937& rng, size_t count) {
+    std::vector<Message> messages;
+    std::vector<int> next(8, 0);
+    uint64_t now = StartNs;
+    for (size_t i = 0; i < count; i++) {
+        int thread = static_cast<int>(rng() % 8);
+        now += 100 * (1 + rng() % 50);
+        messages.push_back(Message{ now, 4000u + thread * 4, 1,
+            L"worker " + std::to_wstring(thread) + L" message number " + std::to_wstring(next[thread]++) });
+    }
+    return messages;
+}
+
+// What a GUI session writes: the application's own messages, mostly from a
+// couple of threads, spaced from a fraction of a millisecond to seconds apart.
+std::vector<Message> MakeSession(std::mt19937& rng, size_t count) {
+    static const wchar_t* const Dlls[] = { L"overlay.dll", L"C:\\Tools\\hook64.dll", L"d3d_helper.dll" };
+    static const wchar_t* const Sections[] = { L".text", L".rdata", L".data", L".pdata", L".reloc" };
+    std::vector<Message> messages;
+    uint64_t now = StartNs;
+
+    auto hex = [&rng] {
+        wchar_t text[24];
+        std::swprintf(text, 24, L"0x%llX", 0x7FF000000000ULL + (rng() % 0x10000) * 0x1000);
+        return std::wstring(text);
+    };
+
+    for (size_t i = 0; i < count; i++) {
+        now += 100 * (1 + rng() % (rng() % 4 == 0 ? 20000000 : 20000));
+        uint32_t thread = rng() % 3 == 0 ? 7120 : 6904 + 4 * (rng() % 3);
+        std::wstring dll = Dlls[rng() % 3];
+        uint32_t pid = 1000 + rng() % 30000;
+
+        auto add = [&](uint8_t level, std::wstring text) {
+            messages.push_back(Message{ now, thread, level, std::move(text) });
+        };
+
+        switch (rng() % 14) {
+            case 0: add(0, L"Process list refreshed: " + std::to_wstring(180 + rng() % 40) + L" processes"); break;
+            case 1: add(0, L"DLL metadata cache hit: " + dll); break;
+            case 2: add(1, L"[ManualMap] Mapped DLL file: " + std::to_wstring(40000 + rng() % 900000) + L" bytes");
+                break;
+            case 3: add(0, L"[ManualMap] Mapping section " + std::wstring(Sections[rng() % 5]) + L" at " + hex());
+                break;
+            case 4: add(0, L"[ManualMap] Relocations processed"); break;
+            case 5: add(0, L"[ManualMap] Imports resolved"); break;
+            case 6: add(1, L"[ManualMap] Manual mapping completed successfully"); break;
+            case 7: add(1, L"[AutoInject] Process started: game.exe (PID " + std::to_wstring(pid) + L")"); break;
+            case 8: add(1, L"[ThreadHijack] Hijacking thread " + std::to_wstring(pid + 4) + L" in PID " +
+                std::to_wstring(pid)); break;
+            case 9: add(2, L"[ThreadHijack] Thread did not resume within 5000 ms"); break;
+            case 10: add(1, L"Injection successful: " + dll + L" -> PID " + std::to_wstring(pid)); break;
+            case 11: add(3, L"OpenProcess: Access is denied."); break;
+            case 12: add(0, L"Settings saved to C:\\Users\\user\\AppData\\Roaming\\xorDLL\\settings.ini"); break;
+            default: add(1, L"Process events from ETW"); break;
+        }
+    }
+    return messages;
+}
+
+// The baseline logger's narrow text line: "[date time] [LEVEL] message\r\n".
+size_t TextSize(const std::vector<Message>& messages) {
+    size_t total = 0;
+    std::string utf8;
+    for (const auto& message : messages) {
+        std::time_t second = static_cast<std::time_t>(message.timestampNs / 1000000000ULL);
+        char stamp[32];
+        size_t stampLength = std::strftime(stamp, sizeof(stamp), "[%Y-%m-%d %H:%M:%S] ", std::gmtime(&second));
+        utf8.clear();
+        BinaryLog::AppendUtf8(utf8, message.text);
+        total += stampLength + 1 + std::strlen(LevelNames[message.level]) + 2 + utf8.size() + 2;
+    }
+    return total;
+}
+
+std::string Encode(const std::vector<Message>& messages, size_t resetEvery = 0) {
+    std::string out;
+    BinaryLog::AppendFileHeader(out);
+    BinaryLog::Encoder encoder;
+    for (size_t i = 0; i < messages.size(); i++) {
+        if (resetEvery && i % resetEvery == 0) {
+            encoder.Reset();
+        }
+        const auto& message = messages[i];
+        encoder.Append(out, message.timestampNs, message.threadId, message.level, message.text);
+    }
+    return out;
+}
+
+// Decodes `data` and compares every record with what was logged. Returns the
+// index of the first mismatch, or messages.size() when all of them match.
+size_t Verify(const std::string& data, const std::vector<Message>& messages) {
+    BinaryLog::Decoder decoder;
+    size_t offset = BinaryLog::FileHeaderSize;
+    for (size_t i = 0; i < messages.size(); i++) {
+        BinaryLogRecord record;
+        size_t consumed = 0;
+        if (decoder.Decode(data.data() + offset, data.size() - offset, record, consumed) != BinaryLog::Status::Ok) {
+            return i;
+        }
+        offset += consumed;
+
+        std::wstring_view tag;
+        std::wstring_view body;
+        BinaryLog::SplitSourceTag(messages[i].text, tag, body);
+        std::string expectedTag;
+        std::string expectedPayload;
+        BinaryLog::AppendUtf8(expectedTag, tag);
+        BinaryLog::AppendUtf8(expectedPayload, body);
+
+        if (record.timestampNs != messages[i].timestampNs || record.threadId != messages[i].threadId ||
+            record.level != messages[i].level || record.tag != expectedTag || record.payload != expectedPayload) {
+            return i;
+        }
+    }
+    return offset == data.size() ? messages.size() : 0;
+}
+
+}
+
+int main(int argc, char** argv) {
+    bool checkOnly = IsCheckOnly(argc, argv);
+    size_t count = checkOnly ? 20000 : 200000;
+    std::mt19937 rng(23);
+
+    std::vector<Message> burst = MakeBurst(rng, count);
+    std::vector<Message> session = MakeSession(rng, count);
+
+    // Out-of-order timestamps, non-ASCII text and surrogate pairs.
+    std::vector<Message> edge = {
+        { StartNs + 5000, 1, 1, L"[\u00C9diteur] caf\u00E9 \U0001F600 done" },
+        { StartNs, 1, 2, L"[\u00C9diteur] caf\u00E9 \U0001F600 again" },
+        { StartNs + 1, 2, 3, L"" },
+        { StartNs + 2, 3, 0, L"[]not a tag" },
+        { StartNs + 3, 3, 0, L"[ThisTagIsFarTooLongToBeATag] body" },
+        { 0, 0xFFFFFFFFu, 1, std::wstring(2000, L'x') },
+    };
+
+    // More threads and tags than a dictionary holds force resets mid-stream.
+    std::vector<Message> churn;
+    for (uint32_t i = 0; i < 3 * BinaryLog::MaxDictionarySize; i++) {
+        std::wstring text = L"[T" + std::to_wstring(i % 600) + L"] thread " + std::to_wstring(i);
+        churn.push_back({ StartNs + i * 1000, 100 + i, 1, text });
+    }
+
+    XORDLL_BENCH_EXPECT(Verify(Encode(burst), burst) == burst.size(), "burst round trip");
+    XORDLL_BENCH_EXPECT(Verify(Encode(session), session) == session.size(), "session round trip");
+    XORDLL_BENCH_EXPECT(Verify(Encode(session, 97), session) == session.size(), "round trip across resets");
+    XORDLL_BENCH_EXPECT(Verify(Encode(edge), edge) == edge.size(), "edge case round trip");
+    XORDLL_BENCH_EXPECT(Verify(Encode(churn), churn) == churn.size(), "dictionary overflow round trip");
+
+    // Every strict prefix of a record is Incomplete and leaves the decoder
+    // able to decode the whole record once it arrives.
+    std::string encoded = Encode(session);
+    BinaryLog::Decoder decoder;
+    size_t offset = BinaryLog::FileHeaderSize;
+    for (size_t i = 0; i < 200; i++) {
+        BinaryLogRecord record;
+        size_t consumed = 0;
+        size_t cut = 0;
+        BinaryLog::Status status;
+        while ((status = decoder.Decode(encoded.data() + offset, cut, record, consumed)) ==
+            BinaryLog::Status::Incomplete) {
+            cut++;
+        }
+        XORDLL_BENCH_EXPECT(status == BinaryLog::Status::Ok && consumed == cut, "record %zu at %zu bytes", i, cut);
+        offset += consumed;
+    }
+    std::vector<Message> head(session.begin(), session.begin() + 200);
+    XORDLL_BENCH_EXPECT(Verify(encoded.substr(0, offset), head) == head.size(), "records decoded piecewise");
+
+    const std::string corrupt[] = {
+        std::string("\x03\x11\x00\x00", 4),
+        std::string("\x05\x09\x01\x00\x02\x00", 6),
+        std::string("\x80\x80\x80\x01", 4),
+    };
+    for (const auto& bad : corrupt) {
+        BinaryLog::Decoder fresh;
+        BinaryLogRecord record;
+        size_t consumed = 0;
+        XORDLL_BENCH_EXPECT(fresh.Decode(bad.data(), bad.size(), record, consumed) == BinaryLog::Status::Corrupt,
+            "corrupt record accepted");
+    }
+
+    std::printf("%-10s %10s %12s %12s %8s\n", "corpus", "records", "text bytes", "xlog bytes", "change");
+    for (const auto* corpus : { &burst, &session }) {
+        size_t text = TextSize(*corpus);
+        size_t binary = Encode(*corpus).size();
+        std::printf("%-10s %10zu %12zu %12zu %7.1f%%\n", corpus == &burst ? "burst" : "session", corpus->size(),
+            text, binary, (static_cast<double>(binary) / text - 1) * 100);
+        XORDLL_BENCH_EXPECT(binary * 2 < text, "xlog is %zu bytes, text %zu", binary, text);
+    }
+
+    if (!checkOnly) {
+        std::string out;
+        double encodeMs = MeasureMs(5, [&] { out = Encode(session); });
+        double decodeMs = MeasureMs(5, [&] { Verify(out, session); });
+        std::printf("encode %.1f ns/record, decode+verify %.1f ns/record\n", encodeMs * 1e6 / session.size(),
+            decodeMs * 1e6 / session.size());
+    }
+    return 0;
+}
@@ -0,0 +1,194 @@
+#include "bench_common.h"
+#include "utils/gzip.h"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace xordll;
+
+namespace {
+
+class Inflater {
+public:
+    Inflater(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    bool Run(std::vector<uint8_t>& out) {
+        bool last = false;
+        while (!last) {
+            last = Bits(1) == 1;
+            uint32_t type = Bits(2);
+            if (type == 0) {
+                if (!Stored(out)) return false;
+            } else if (type == 1) {
+                if (!Fixed(out)) return false;
+            } else {
+                return false;
+            }
+            if (m_overrun) return false;
+        }
+        return !m_overrun;
+    }
+
+    size_t BytesConsumed() const { return (m_bit + 7) / 8; }
+
+private:
+    uint32_t Bits(int count) {
+        uint32_t value = 0;
+        for (int i = 0; i < count; i++, m_bit++) {
+            if (m_bit / 8 >= m_size) {
+                m_overrun = true;
+                return 0;
+            }
+            value |= static_cast<uint32_t>((m_data[m_bit / 8] >> (m_bit % 8)) & 1) << i;
+        }
+        return value;
+    }
+
+    uint32_t HuffmanBits(int count) {
+        uint32_t value = 0;
+        for (int i = 0; i < count; i++) {
+            value = (value << 1) | Bits(1);
+        }
+        return value;
+    }
+
+    uint32_t FixedSymbol() {
+        uint32_t code = HuffmanBits(7);
+        if (code <= 0x17) return 256 + code;
+        code = (code << 1) | Bits(1);
+        if (code >= 0x30 && code <= 0xBF) return code - 0x30;
+        if (code >= 0xC0 && code <= 0xC7) return 280 + code - 0xC0;
+        code = (code << 1) | Bits(1);
+        return 144 + code - 0x190;
+    }
+
+    bool Stored(std::vector<uint8_t>& out) {
+        m_bit = (m_bit + 7) & ~size_t(7);
+        uint32_t length = Bits(16);
+        uint32_t complement = Bits(16);
+        if ((length ^ 0xFFFF) != complement) return false;
+        for (uint32_t i = 0; i < length; i++) {
+            out.push_back(static_cast<uint8_t>(Bits(8)));
+        }
+        return true;
+    }
+
+    bool Fixed(std::vector<uint8_t>& out) {
+        static const uint16_t LengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43,
+            51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+        static const uint16_t DistanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257,
+            385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+
+        for (;;) {
+            uint32_t symbol = FixedSymbol();
+            if (m_overrun) return false;
+            if (symbol < 256) {
+                out.push_back(static_cast<uint8_t>(symbol));
+                continue;
+            }
+            if (symbol == 256) return true;
+            if (symbol > 285) return false;
+
+            uint32_t lengthCode = symbol - 257;
+            uint32_t lengthExtra = lengthCode < 8 || lengthCode == 28 ? 0 : (lengthCode - 4) / 4;
+            size_t length = LengthBase[lengthCode] + Bits(lengthExtra);
+
+            uint32_t distanceCode = HuffmanBits(5);
+            if (distanceCode > 29) return false;
+            uint32_t distanceExtra = distanceCode < 4 ? 0 : (distanceCode - 2) / 2;
+            size_t distance = DistanceBase[distanceCode] + Bits(distanceExtra);
+            if (distance > out.size()) return false;
+
+            for (size_t i = 0; i < length; i++) {
+                out.push_back(out[out.size() - distance]);
+            }
+        }
+    }
+
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_bit = 0;
+    bool m_overrun = false;
+};
+
+uint32_t ReferenceCrc32(const std::vector<uint8_t>& data) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (uint8_t byte : data) {
+        crc ^= byte;
+        for (int k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+uint32_t ReadLittleEndian(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+int RoundTrip(const char* name, const std::vector<uint8_t>& input) {
+    std::vector<uint8_t> compressed;
+    utils::GzipCompress(input.data(), input.size(), compressed);
+
+    XORDLL_BENCH_EXPECT(compressed.size() >= 18, "%s: %zu byte stream", name, compressed.size());
+    XORDLL_BENCH_EXPECT(compressed[0] == 0x1F && compressed[1] == 0x8B && compressed[2] == 8 && compressed[3] == 0,
+        "%s: bad gzip header", name);
+
+    std::vector<uint8_t> output;
+    Inflater inflater(compressed.data() + 10, compressed.size() - 18);
+    XORDLL_BENCH_EXPECT(inflater.Run(output), "%s: deflate stream did not decode", name);
+    XORDLL_BENCH_EXPECT(inflater.BytesConsumed() == compressed.size() - 18, "%s: %zu trailing deflate bytes", name,
+        compressed.size() - 18 - inflater.BytesConsumed());
+    XORDLL_BENCH_EXPECT(output == input, "%s: decoded %zu bytes, expected %zu", name, output.size(), input.size());
+
+    const uint8_t* trailer = compressed.data() + compressed.size() - 8;
+    XORDLL_BENCH_EXPECT(ReadLittleEndian(trailer) == ReferenceCrc32(input), "%s: CRC mismatch", name);
+    XORDLL_BENCH_EXPECT(ReadLittleEndian(trailer + 4) == static_cast<uint32_t>(input.size()), "%s: ISIZE mismatch",
+        name);
+    XORDLL_BENCH_EXPECT(utils::Crc32(input.data(), input.size()) == ReferenceCrc32(input), "%s: Crc32 mismatch", name);
+
+    std::printf("%-12s %8zu -> %8zu bytes\n", name, input.size(), compressed.size());
+    return 0;
+}
+
+}
+
+int main() {
+    std::mt19937 rng(0x6A1F);
+
+    std::vector<uint8_t> random(200000);
+    for (auto& byte : random) {
+        byte = static_cast<uint8_t>(rng());
+    }
+
+    std::vector<uint8_t> zeros(100000, 0);
+
+    std::vector<uint8_t> repetitive;
+    while (repetitive.size() < 150000) {
+        std::string line = "[2026-10-17 12:00:00.000] [INFO] [" + std::to_string(rng() % 16) +
+            "] Injection into PID " + std::to_string(rng() % 50000) + " succeeded\n";
+        repetitive.insert(repetitive.end(), line.begin(), line.end());
+    }
+
+    std::vector<uint8_t> mixed;
+    for (int block = 0; block < 40; block++) {
+        size_t start = mixed.size();
+        if (block % 2) {
+            for (int i = 0; i < 1000; i++) mixed.push_back(static_cast<uint8_t>(rng()));
+        } else if (start >= 20000) {
+            mixed.insert(mixed.end(), mixed.begin() + (start - 19000), mixed.begin() + (start - 18000));
+        } else {
+            mixed.insert(mixed.end(), 1000, static_cast<uint8_t>(block));
+        }
+    }
+
+    if (int result = RoundTrip("empty", {})) return result;
+    if (int result = RoundTrip("one byte", { 0xA7 })) return result;
+    if (int result = RoundTrip("three bytes", { 'a', 'a', 'a' })) return result;
+    if (int result = RoundTrip("random", random)) return result;
+    if (int result = RoundTrip("zeros", zeros)) return result;
+    if (int result = RoundTrip("log lines", repetitive)) return result;
+    if (int result = RoundTrip("mixed", mixed)) return result;
+    std::printf("gzip: ok\n");
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "bench_common.h"
+#include "ui/icon_cache.h"
+#include <map>
+
+using namespace xordll::ui;
+
+namespace {
+
+// Stands in for the image list: records which path was loaded into which
+// slot and fails for any path listed in `broken`.
+struct FakeIconLoader {
+    std::map<int, std::wstring> slots;
+    std::vector<std::wstring> broken;
+    int loads = 0;
+
+    IconCache::LoadFunction Function() {
+        return [this](const std::wstring& path, int slot) {
+            loads++;
+            for (const auto& bad : broken) {
+                if (bad == path) {
+                    return false;
+                }
+            }
+            slots[slot] = path;
+            return true;
+        };
+    }
+};
+
+int TestSlotReuseAfterEviction() {
+    FakeIconLoader loader;
+    IconCache cache(loader.Function(), 1);
+
+    cache.Update({ L"C:\\a.exe", L"C:\\b.exe", L"C:\\c.exe" });
+    XORDLL_BENCH_EXPECT(cache.SlotCount() == 3, "slots %d", cache.SlotCount());
+    int evicted = cache.IndexOf(L"C:\\b.exe");
+    XORDLL_BENCH_EXPECT(evicted >= 1 && evicted <= 3, "slot %d", evicted);
+
+    cache.Update({ L"C:\\a.exe", L"C:\\c.exe" });
+    XORDLL_BENCH_EXPECT(cache.IndexOf(L"C:\\b.exe") == IconCache::NoIcon, "b.exe still cached");
+    XORDLL_BENCH_EXPECT(cache.Size() == 2, "size %zu", cache.Size());
+
+    cache.Update({ L"C:\\a.exe", L"C:\\c.exe", L"C:\\d.exe" });
+    XORDLL_BENCH_EXPECT(cache.IndexOf(L"C:\\d.exe") == evicted, "d.exe got %d, expected %d",
+        cache.IndexOf(L"C:\\d.exe"), evicted);
+    XORDLL_BENCH_EXPECT(cache.SlotCount() == 3, "image list grew to %d", cache.SlotCount());
+    XORDLL_BENCH_EXPECT(loader.slots[evicted] == L"C:\\d.exe", "slot not reloaded");
+    XORDLL_BENCH_EXPECT(loader.loads == 4, "loads %d", loader.loads);
+    return 0;
+}
+
+int TestDuplicatePathRefcounts() {
+    FakeIconLoader loader;
+    IconCache cache(loader.Function());
+
+    cache.Update({ L"C:\\Shared.exe", L"c:\\shared.EXE", L"C:\\SHARED.exe" });
+    XORDLL_BENCH_EXPECT(loader.loads == 1, "loads %d", loader.loads);
+    XORDLL_BENCH_EXPECT(cache.Size() == 1 && cache.SlotCount() == 1, "size %zu", cache.Size());
+    int slot = cache.IndexOf(L"C:\\shared.exe");
+
+    cache.Update({ L"C:\\shared.exe" });
+    XORDLL_BENCH_EXPECT(cache.IndexOf(L"C:\\Shared.exe") == slot, "slot moved while referenced");
+
+    int acquired = cache.Acquire(L"C:\\SHARED.EXE");
+    XORDLL_BENCH_EXPECT(acquired == slot, "acquire returned %d", acquired);
+    cache.Update({});
+    XORDLL_BENCH_EXPECT(cache.IndexOf(L"C:\\shared.exe") == slot, "released while acquired");
+
+    cache.Release(L"c:\\shared.exe");
+    XORDLL_BENCH_EXPECT(cache.IndexOf(L"C:\\shared.exe") == IconCache::NoIcon, "not released");
+    XORDLL_BENCH_EXPECT(cache.Size() == 0, "size %zu", cache.Size());
+    XORDLL_BENCH_EXPECT(loader.loads == 1, "loads %d", loader.loads);
+    return 0;
+}
+
+int TestFailedLoadFreesSlot() {
+    FakeIconLoader loader;
+    loader.broken = { L"C:\\broken.exe" };
+    IconCache cache(loader.Function(), 1);
+
+    int slot = cache.Acquire(L"C:\\broken.exe");
+    XORDLL_BENCH_EXPECT(slot == IconCache::NoIcon, "broken.exe got slot %d", slot);
+    XORDLL_BENCH_EXPECT(cache.IndexOf(L"C:\\broken.exe") == IconCache::NoIcon, "broken.exe indexed");
+
+    int next = cache.Acquire(L"C:\\good.exe");
+    XORDLL_BENCH_EXPECT(next == 1, "good.exe got slot %d, expected the freed slot 1", next);
+    XORDLL_BENCH_EXPECT(cache.SlotCount() == 1, "slots %d", cache.SlotCount());
+
+    int loads = loader.loads;
+    XORDLL_BENCH_EXPECT(cache.Acquire(L"C:\\broken.exe") == IconCache::NoIcon, "retry succeeded");
+    XORDLL_BENCH_EXPECT(loader.loads == loads, "failed load retried while still referenced");
+
+    cache.Release(L"C:\\broken.exe");
+    cache.Release(L"C:\\broken.exe");
+    XORDLL_BENCH_EXPECT(cache.Size() == 1, "size %zu", cache.Size());
+    XORDLL_BENCH_EXPECT(cache.Acquire(L"C:\\other.exe") == 2, "slot sequence broken");
+    return 0;
+}
+
+}
+
+int main() {
+    if (int result = TestSlotReuseAfterEviction()) return result;
+    if (int result = TestDuplicatePathRefcounts()) return result;
+    if (int result = TestFailedLoadFreesSlot()) return result;
+    std::printf("icon cache: ok\n");
+    return 0;
+}
@@ -0,0 +1,176 @@
+#include "bench_common.h"
+#include "utils/log_history.h"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace xordll;
+
+namespace {
+
+using Clock = std::chrono::system_clock;
+
+struct Expected {
+    uint64_t sequence;
+    LogLevel level;
+    Clock::time_point timestamp;
+    uint32_t threadId;
+    std::wstring message;
+};
+
+uint64_t AppendExpected(LogHistory& history, std::vector<Expected>& all, std::wstring message) {
+    Expected expected;
+    expected.level = static_cast<LogLevel>(all.size() % 4);
+    expected.threadId = 1000 + static_cast<uint32_t>(all.size() % 13);
+    expected.timestamp = Clock::time_point(std::chrono::milliseconds(1700000000000LL + 7 * all.size()));
+    expected.message = std::move(message);
+    expected.sequence = history.Append(expected.level, expected.timestamp, expected.threadId, expected.message);
+    size_t maxLength = history.Capacity() * LogHistory::AverageMessageLength / 4;
+    expected.message.resize(std::min(expected.message.size(), maxLength));
+    all.push_back(std::move(expected));
+    return all.back().sequence;
+}
+
+int CheckRecords(const char* name, const std::vector<LogRecordView>& views, const std::vector<Expected>& all,
+    uint64_t firstSequence) {
+    for (size_t i = 0; i < views.size(); i++) {
+        const LogRecordView& view = views[i];
+        XORDLL_BENCH_EXPECT(view.sequence == firstSequence + i, "%s: record %zu has sequence %llu, expected %llu",
+            name, i, static_cast<unsigned long long>(view.sequence),
+            static_cast<unsigned long long>(firstSequence + i));
+
+        XORDLL_BENCH_EXPECT(view.sequence >= 1 && view.sequence <= all.size() && all[view.sequence - 1].sequence ==
+            view.sequence, "%s: unknown sequence %llu", name, static_cast<unsigned long long>(view.sequence));
+        const Expected* expected = &all[view.sequence - 1];
+        XORDLL_BENCH_EXPECT(view.level == expected->level && view.timestamp == expected->timestamp,
+            "%s: sequence %llu level or time differs", name, static_cast<unsigned long long>(view.sequence));
+        XORDLL_BENCH_EXPECT(view.threadId == expected->threadId, "%s: sequence %llu thread %u, expected %u", name,
+            static_cast<unsigned long long>(view.sequence), view.threadId, expected->threadId);
+        XORDLL_BENCH_EXPECT(view.message == expected->message, "%s: sequence %llu message of %zu chars, expected %zu",
+            name, static_cast<unsigned long long>(view.sequence), view.message.size(), expected->message.size());
+    }
+    return 0;
+}
+
+std::vector<LogRecordView> ReadAll(const LogHistory& history) {
+    std::vector<LogRecordView> views;
+    history.Read(0, history.Capacity(), [&](const LogRecordView& view) { views.push_back(view); });
+    return views;
+}
+
+int TestSequenceOrder() {
+    LogHistory history(8);
+    std::vector<Expected> all;
+
+    for (int i = 0; i < 6; i++) {
+        uint64_t sequence = AppendExpected(history, all, L"entry " + std::to_wstring(i));
+        XORDLL_BENCH_EXPECT(sequence == static_cast<uint64_t>(i + 1), "append %d got sequence %llu", i,
+            static_cast<unsigned long long>(sequence));
+    }
+    XORDLL_BENCH_EXPECT(history.Size() == 6 && history.LastSequence() == 6, "size %zu, last %llu", history.Size(),
+        static_cast<unsigned long long>(history.LastSequence()));
+
+    std::vector<LogRecordView> views = ReadAll(history);
+    XORDLL_BENCH_EXPECT(views.size() == 6, "read %zu of 6", views.size());
+    if (int result = CheckRecords("order", views, all, 1)) return result;
+
+    views.clear();
+    uint64_t last = history.Read(2, 3, [&](const LogRecordView& view) { views.push_back(view); });
+    XORDLL_BENCH_EXPECT(views.size() == 3 && last == 5, "read after 2 returned %zu up to %llu", views.size(),
+        static_cast<unsigned long long>(last));
+    if (int result = CheckRecords("after", views, all, 3)) return result;
+
+    XORDLL_BENCH_EXPECT(history.Read(6, 10, [](const LogRecordView&) {}) == 6, "read past the end moved the cursor");
+
+    views.clear();
+    history.ReadRecent(2, [&](const LogRecordView& view) { views.push_back(view); });
+    XORDLL_BENCH_EXPECT(views.size() == 2, "recent returned %zu", views.size());
+    if (int result = CheckRecords("recent", views, all, 5)) return result;
+
+    for (int i = 6; i < 20; i++) {
+        AppendExpected(history, all, L"entry " + std::to_wstring(i));
+    }
+    XORDLL_BENCH_EXPECT(history.Size() == 8, "size %zu at capacity 8", history.Size());
+    views = ReadAll(history);
+    XORDLL_BENCH_EXPECT(views.size() == 8, "read %zu after slot wrap", views.size());
+    return CheckRecords("slot wrap", views, all, 13);
+}
+
+int TestArenaWrap() {
+    LogHistory history(16);
+    std::vector<Expected> all;
+    std::mt19937 rng(0x10C5);
+    const size_t maxLength = history.Capacity() * LogHistory::AverageMessageLength / 4;
+
+    for (int i = 0; i < 3000; i++) {
+        size_t length;
+        switch (rng() % 4) {
+        case 0: length = 0; break;
+        case 1: length = 1 + rng() % 40; break;
+        case 2: length = 100 + rng() % 400; break;
+        default: length = maxLength - 8 + rng() % 16; break;
+        }
+        std::wstring message(length, L' ');
+        for (size_t c = 0; c < length; c++) {
+            message[c] = static_cast<wchar_t>(L'a' + (i + c) % 26);
+        }
+        AppendExpected(history, all, std::move(message));
+
+        size_t size = history.Size();
+        XORDLL_BENCH_EXPECT(size >= 1 && size <= history.Capacity(), "append %d left %zu records", i, size);
+
+        std::vector<LogRecordView> views = ReadAll(history);
+        XORDLL_BENCH_EXPECT(views.size() == size, "append %d: read %zu of %zu", i, views.size(), size);
+        XORDLL_BENCH_EXPECT(views.back().sequence == history.LastSequence(), "append %d: newest record missing", i);
+        if (int result = CheckRecords("arena wrap", views, all, history.LastSequence() - size + 1)) return result;
+    }
+    return 0;
+}
+
+int TestClearAndReset() {
+    LogHistory history(4);
+    std::vector<Expected> all;
+
+    for (int i = 0; i < 3; i++) {
+        AppendExpected(history, all, L"before clear " + std::to_wstring(i));
+    }
+    history.Clear();
+    XORDLL_BENCH_EXPECT(history.Size() == 0, "%zu records after Clear", history.Size());
+    XORDLL_BENCH_EXPECT(history.LastSequence() == 3, "Clear rewound the sequence to %llu",
+        static_cast<unsigned long long>(history.LastSequence()));
+    XORDLL_BENCH_EXPECT(ReadAll(history).empty(), "records visible after Clear");
+
+    uint64_t sequence = AppendExpected(history, all, L"after clear");
+    XORDLL_BENCH_EXPECT(sequence == 4, "first append after Clear got %llu", static_cast<unsigned long long>(sequence));
+    std::vector<LogRecordView> views = ReadAll(history);
+    XORDLL_BENCH_EXPECT(views.size() == 1, "read %zu after Clear", views.size());
+    if (int result = CheckRecords("clear", views, all, 4)) return result;
+
+    history.Reset(32);
+    XORDLL_BENCH_EXPECT(history.Capacity() == 32 && history.Size() == 0, "capacity %zu, size %zu after Reset",
+        history.Capacity(), history.Size());
+    for (int i = 0; i < 40; i++) {
+        AppendExpected(history, all, L"after reset " + std::to_wstring(i));
+    }
+    views = ReadAll(history);
+    XORDLL_BENCH_EXPECT(views.size() == 32, "read %zu after Reset", views.size());
+    if (int result = CheckRecords("reset", views, all, 13)) return result;
+
+    history.Reset(0);
+    XORDLL_BENCH_EXPECT(history.Capacity() == 1, "Reset(0) gave capacity %zu", history.Capacity());
+    AppendExpected(history, all, L"one");
+    AppendExpected(history, all, L"two");
+    views = ReadAll(history);
+    XORDLL_BENCH_EXPECT(views.size() == 1, "read %zu at capacity 1", views.size());
+    return CheckRecords("capacity 1", views, all, 46);
+}
+
+}
+
+int main() {
+    if (int result = TestSequenceOrder()) return result;
+    if (int result = TestArenaWrap()) return result;
+    if (int result = TestClearAndReset()) return result;
+    std::printf("log history: ok\n");
+    return 0;
+}
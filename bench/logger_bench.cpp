@@ -0,0 +1,133 @@
+#include "bench_common.h"
+#include "baseline_logger.h"
+#include "utils/logger.h"
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace xordll;
+using namespace xordll::bench;
+
+namespace {
+
+constexpr int ThreadCount = 8;
+
+std::wstring Message(int thread, int index) {
+    return L"worker " + std::to_wstring(thread) + L" message number " + std::to_wstring(index);
+}
+
+struct Timing {
+    double producersMs;
+    double totalMs;
+};
+
+// Runs ThreadCount producers that each log `count` messages; the total
+// includes `drain`, which has to leave every message on disk.
+template <typename LogFn, typename DrainFn>
+Timing Run(int count, LogFn log, DrainFn drain) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < ThreadCount; t++) {
+        threads.emplace_back([t, count, &log] {
+            for (int i = 0; i < count; i++) {
+                log(Message(t, i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto produced = std::chrono::steady_clock::now();
+
+    drain();
+    auto drained = std::chrono::steady_clock::now();
+
+    return Timing{
+        std::chrono::duration<double, std::milli>(produced - start).count(),
+        std::chrono::duration<double, std::milli>(drained - start).count()
+    };
+}
+
+// Every worker message must be in the file exactly once and in the order its
+// thread logged it. Returns the number of worker lines found, or -1 on a
+// duplicate, gap or reordering.
+long CountWorkerLines(const std::wstring& path, int count) {
+    std::ifstream file(std::string(path.begin(), path.end()), std::ios::binary);
+    std::vector<int> next(ThreadCount, 0);
+    long found = 0;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        int thread = 0;
+        int index = 0;
+        size_t at = line.find("] worker ");
+        if (at == std::string::npos ||
+            std::sscanf(line.c_str() + at, "] worker %d message number %d", &thread, &index) != 2) {
+            continue;
+        }
+        if (thread < 0 || thread >= ThreadCount || index != next[thread]) {
+            return -1;
+        }
+        next[thread]++;
+        found++;
+    }
+
+    for (int n : next) {
+        if (n != count) {
+            return -1;
+        }
+    }
+    return found;
+}
+
+}
+
+int main(int argc, char** argv) {
+    bool checkOnly = IsCheckOnly(argc, argv);
+    int count = checkOnly ? 2000 : 100000;
+
+    std::wstring baselinePath = L"logger_bench_baseline.log";
+    std::wstring currentPath = L"logger_bench_current.log";
+    DeleteFileW(baselinePath.c_str());
+    DeleteFileW(currentPath.c_str());
+
+    BaselineLogger baseline;
+    XORDLL_BENCH_EXPECT(baseline.Initialize(baselinePath), "cannot open baseline log");
+    Timing before = Run(count,
+        [&baseline](const std::wstring& message) { baseline.Log(LogLevel::Info, message); },
+        [&baseline] { baseline.Shutdown(); });
+
+    // Block instead of dropping so both loggers write the same lines.
+    Logger& logger = Logger::Instance();
+    LogRotationPolicy rotation;
+    rotation.maxFileSize = SIZE_MAX;
+    rotation.maxFileAge = std::chrono::seconds(0);
+    XORDLL_BENCH_EXPECT(logger.Initialize(currentPath, SIZE_MAX), "cannot open logger log");
+    logger.SetRotationPolicy(rotation);
+    logger.SetOverflowPolicy(LogOverflowPolicy::Block);
+    Timing after = Run(count,
+        [](const std::wstring& message) { LOG_INFO(message); },
+        [&logger] { logger.Shutdown(); });
+
+    long expected = static_cast<long>(ThreadCount) * count;
+    long baselineLines = CountWorkerLines(baselinePath, count);
+    long currentLines = CountWorkerLines(currentPath, count);
+    XORDLL_BENCH_EXPECT(baselineLines == expected, "baseline wrote %ld of %ld lines in order", baselineLines, expected);
+    XORDLL_BENCH_EXPECT(currentLines == expected, "logger wrote %ld of %ld lines in order", currentLines, expected);
+    XORDLL_BENCH_EXPECT(logger.GetDroppedCount() == 0, "%llu entries dropped",
+        static_cast<unsigned long long>(logger.GetDroppedCount()));
+
+    double messages = static_cast<double>(expected);
+    std::printf("%d threads x %d messages\n", ThreadCount, count);
+    std::printf("%-10s %14s %14s %14s\n", "logger", "producers ms", "with drain ms", "msgs/s");
+    std::printf("%-10s %14.1f %14.1f %14.0f\n", "baseline", before.producersMs, before.totalMs,
+        messages / before.totalMs * 1000);
+    std::printf("%-10s %14.1f %14.1f %14.0f\n", "current", after.producersMs, after.totalMs,
+        messages / after.totalMs * 1000);
+
+    DeleteFileW(baselinePath.c_str());
+    DeleteFileW(currentPath.c_str());
+    return 0;
+}
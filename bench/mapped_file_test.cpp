@@ -0,0 +1,96 @@
+#include "bench_common.h"
+#include "utils/mapped_file.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace xordll;
+using utils::MappedFile;
+
+namespace {
+
+MappedFile::PathType PathOf(const std::string& name) {
+    return MappedFile::PathType(name.begin(), name.end());
+}
+
+bool WriteFile(const std::string& name, const std::vector<uint8_t>& data) {
+    std::ofstream file(name, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return file.good();
+}
+
+bool Holds(const MappedFile& file, const std::vector<uint8_t>& data) {
+    return file.IsOpen() && file.Size() == data.size() && file.Data() &&
+        std::equal(data.begin(), data.end(), file.Data());
+}
+
+int TestContents(const std::string& name, const std::vector<uint8_t>& data) {
+    XORDLL_BENCH_EXPECT(WriteFile(name, data), "could not write %s", name.c_str());
+
+    MappedFile file;
+    XORDLL_BENCH_EXPECT(file.Open(PathOf(name)), "could not map %s", name.c_str());
+    XORDLL_BENCH_EXPECT(Holds(file, data), "%s: mapped %zu bytes, expected %zu", name.c_str(), file.Size(),
+        data.size());
+
+    MappedFile constructed(PathOf(name));
+    XORDLL_BENCH_EXPECT(Holds(constructed, data), "%s: constructor mapped %zu bytes", name.c_str(),
+        constructed.Size());
+
+    file.Close();
+    XORDLL_BENCH_EXPECT(!file.IsOpen() && !file.Data() && file.Size() == 0, "%s: state left after Close",
+        name.c_str());
+    std::remove(name.c_str());
+    return 0;
+}
+
+}
+
+int main() {
+    std::mt19937 rng(0x3A9);
+
+    std::vector<uint8_t> small = { 'M', 'Z', 0x90, 0x00 };
+    std::vector<uint8_t> large(3 * 4096 + 123);
+    for (auto& byte : large) {
+        byte = static_cast<uint8_t>(rng());
+    }
+
+    if (int result = TestContents("mapped_file_small.bin", small)) return result;
+    if (int result = TestContents("mapped_file_large.bin", large)) return result;
+
+    XORDLL_BENCH_EXPECT(WriteFile("mapped_file_empty.bin", {}), "could not write the empty file");
+    MappedFile empty;
+    XORDLL_BENCH_EXPECT(empty.Open(PathOf("mapped_file_empty.bin")), "empty file not opened");
+    XORDLL_BENCH_EXPECT(empty.IsOpen() && empty.Size() == 0 && !empty.Data(), "empty file mapped %zu bytes",
+        empty.Size());
+    std::remove("mapped_file_empty.bin");
+
+    MappedFile missing;
+    XORDLL_BENCH_EXPECT(!missing.Open(PathOf("mapped_file_missing.bin")), "missing file opened");
+    XORDLL_BENCH_EXPECT(!missing.IsOpen() && !missing.Data() && missing.Size() == 0, "missing file left state");
+
+    MappedFile directory;
+    XORDLL_BENCH_EXPECT(!directory.Open(PathOf(".")), "directory opened as a file");
+
+    XORDLL_BENCH_EXPECT(WriteFile("mapped_file_move.bin", large), "could not write the move file");
+    MappedFile source(PathOf("mapped_file_move.bin"));
+    MappedFile moved(std::move(source));
+    XORDLL_BENCH_EXPECT(Holds(moved, large) && !source.IsOpen() && !source.Data(), "move construction");
+
+    MappedFile assigned;
+    XORDLL_BENCH_EXPECT(WriteFile("mapped_file_small.bin", small), "could not write the small file");
+    assigned.Open(PathOf("mapped_file_small.bin"));
+    assigned = std::move(moved);
+    XORDLL_BENCH_EXPECT(Holds(assigned, large) && !moved.IsOpen(), "move assignment");
+
+    XORDLL_BENCH_EXPECT(!assigned.Open(PathOf("mapped_file_missing.bin")) && !assigned.IsOpen(),
+        "failed reopen kept the old mapping");
+    std::remove("mapped_file_move.bin");
+    std::remove("mapped_file_small.bin");
+
+    std::printf("mapped file: ok\n");
+    return 0;
+}
@@ -0,0 +1,178 @@
+#include "bench_common.h"
+#include "core/injection_core.h"
+#include "core/process_monitor.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+using namespace xordll;
+using namespace xordll::bench;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr ProcessId FirstPid = 10000;
+
+class SyntheticEventSource : public ProcessEventSource {
+public:
+    bool Start(Sink sink, StopHandler) override {
+        m_sink = std::move(sink);
+        return true;
+    }
+
+    void Stop() override {}
+
+    const wchar_t* Name() const override { return L"synthetic"; }
+
+    void Push(ProcessEvent event, ProcessId pid) {
+        m_sink(ProcessEventNotification{ event, pid });
+    }
+
+private:
+    Sink m_sink;
+};
+
+class TableEnumerator : public ProcessEnumerator {
+public:
+    bool Enumerate(ProcessEnumeration& out, bool) override {
+        out.Clear();
+        std::lock_guard<std::mutex> lock(xordll_win32::ProcessMutex());
+        for (const auto& pair : xordll_win32::Processes()) {
+            ProcessRecord record;
+            record.pid = pair.first;
+            record.creationTime = pair.second.creationTime;
+            record.imageName = pair.second.path.substr(pair.second.path.find_last_of(L'\\') + 1);
+            out.processes.push_back(std::move(record));
+        }
+        return true;
+    }
+
+    const wchar_t* Name() const override { return L"table"; }
+};
+
+struct Observed {
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::vector<ProcessInfo> started;
+    std::vector<ProcessInfo> terminated;
+    Clock::time_point last;
+};
+
+bool WaitForCount(Observed& observed, const std::vector<ProcessInfo>& events, size_t count) {
+    std::unique_lock<std::mutex> lock(observed.mutex);
+    return observed.condition.wait_for(lock, std::chrono::seconds(5), [&] { return events.size() >= count; });
+}
+
+double Percentile(std::vector<double> samples, double fraction) {
+    std::sort(samples.begin(), samples.end());
+    return samples[std::min(samples.size() - 1, static_cast<size_t>(fraction * samples.size()))];
+}
+
+}
+
+namespace xordll {
+
+std::unique_ptr<ProcessEventSource> ProcessEventSource::Create() {
+    return nullptr;
+}
+
+std::unique_ptr<ProcessEnumerator> ProcessEnumerator::Create() {
+    return std::make_unique<TableEnumerator>();
+}
+
+bool ProcessEnumerator::EnumerateWithFallback(
+    std::unique_ptr<ProcessEnumerator>& enumerator,
+    ProcessEnumeration& out,
+    bool includeThreads
+) {
+    return enumerator->Enumerate(out, includeThreads);
+}
+
+InjectionCore::InjectionCore() {}
+InjectionCore::~InjectionCore() {}
+
+InjectionResult InjectionCore::Inject(ProcessId, const std::wstring&, InjectionMethod, ProgressCallback) {
+    return InjectionResult();
+}
+
+void InjectionCore::SetLogCallback(LogCallback callback) {
+    m_logCallback = std::move(callback);
+}
+
+}
+
+int main(int argc, char** argv) {
+    bool checkOnly = IsCheckOnly(argc, argv);
+    int rounds = checkOnly ? 200 : 5000;
+
+    Observed observed;
+    ProcessMonitor monitor;
+    auto source = std::make_unique<SyntheticEventSource>();
+    SyntheticEventSource* events = source.get();
+    monitor.SetEventSource(std::move(source));
+    monitor.WatchProcess(L"target.exe");
+    monitor.SetCallback([&](ProcessEvent event, const ProcessInfo& process) {
+        std::lock_guard<std::mutex> lock(observed.mutex);
+        observed.last = Clock::now();
+        (event == ProcessEvent::Started ? observed.started : observed.terminated).push_back(process);
+        observed.condition.notify_all();
+    });
+
+    XORDLL_BENCH_EXPECT(monitor.Start(), "monitor did not start");
+    XORDLL_BENCH_EXPECT(monitor.IsEventDriven(), "synthetic source not used");
+
+    std::vector<double> startUs;
+    std::vector<double> stopUs;
+    startUs.reserve(rounds);
+    stopUs.reserve(rounds);
+    for (int i = 0; i < rounds; i++) {
+        ProcessId pid = FirstPid + i;
+        uint64_t creationTime = 0x01D9000000000000ULL + i;
+
+        xordll_win32::AddProcess(pid + rounds, L"C:\\Windows\\other.exe", creationTime);
+        events->Push(ProcessEvent::Started, pid + rounds);
+
+        xordll_win32::AddProcess(pid, L"C:\\Games\\Target.exe", creationTime);
+        auto start = Clock::now();
+        events->Push(ProcessEvent::Started, pid);
+        XORDLL_BENCH_EXPECT(WaitForCount(observed, observed.started, i + 1), "no start callback for pid %lu",
+            static_cast<unsigned long>(pid));
+        {
+            std::lock_guard<std::mutex> lock(observed.mutex);
+            const ProcessInfo& info = observed.started.back();
+            XORDLL_BENCH_EXPECT(info.pid == pid && info.name == L"Target.exe" && info.creationTime == creationTime,
+                "start reported pid %lu", static_cast<unsigned long>(info.pid));
+            startUs.push_back(std::chrono::duration<double, std::micro>(observed.last - start).count());
+        }
+
+        xordll_win32::RemoveProcess(pid);
+        xordll_win32::RemoveProcess(pid + rounds);
+        start = Clock::now();
+        events->Push(ProcessEvent::Terminated, pid + rounds);
+        events->Push(ProcessEvent::Terminated, pid);
+        XORDLL_BENCH_EXPECT(WaitForCount(observed, observed.terminated, i + 1), "no stop callback for pid %lu",
+            static_cast<unsigned long>(pid));
+        {
+            std::lock_guard<std::mutex> lock(observed.mutex);
+            XORDLL_BENCH_EXPECT(observed.terminated.back().pid == pid, "stop reported pid %lu",
+                static_cast<unsigned long>(observed.terminated.back().pid));
+            stopUs.push_back(std::chrono::duration<double, std::micro>(observed.last - start).count());
+        }
+    }
+
+    monitor.Stop();
+    XORDLL_BENCH_EXPECT(observed.started.size() == static_cast<size_t>(rounds), "%zu start callbacks for %d starts",
+        observed.started.size(), rounds);
+    XORDLL_BENCH_EXPECT(observed.terminated.size() == static_cast<size_t>(rounds), "%zu stop callbacks for %d stops",
+        observed.terminated.size(), rounds);
+
+    std::printf("%d watched starts and stops, as many unwatched\n", rounds);
+    std::printf("%-8s %10s %10s %10s\n", "event", "p50 us", "p99 us", "max us");
+    std::printf("%-8s %10.1f %10.1f %10.1f\n", "start", Percentile(startUs, 0.5), Percentile(startUs, 0.99),
+        Percentile(startUs, 1.0));
+    std::printf("%-8s %10.1f %10.1f %10.1f\n", "stop", Percentile(stopUs, 0.5), Percentile(stopUs, 0.99),
+        Percentile(stopUs, 1.0));
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include "bench_common.h"
+#include "core/process_search_index.h"
+#include <clocale>
+#include <cwctype>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace xordll;
+using namespace xordll::bench;
+
+namespace {
+
+constexpr size_t NameCount = 10000;
+
+std::wstring ToLower(std::wstring text) {
+    for (auto& c : text) {
+        c = static_cast<wchar_t>(std::towlower(c));
+    }
+    return text;
+}
+
+// What the process list filter did before the index: lowercase every name
+// and run a substring search per row.
+void NaiveFind(const std::vector<std::wstring>& names, const std::wstring& query, std::vector<uint32_t>& matches) {
+    matches.clear();
+    std::wstring needle = ToLower(query);
+    for (uint32_t i = 0; i < names.size(); i++) {
+        if (ToLower(names[i]).find(needle) != std::wstring::npos) {
+            matches.push_back(i);
+        }
+    }
+}
+
+std::string Printable(const std::wstring& text) {
+    std::string out;
+    for (wchar_t c : text) {
+        out.push_back(c >= 0x20 && c < 0x7F ? static_cast<char>(c) : '?');
+    }
+    return out;
+}
+
+std::vector<std::wstring> MakeNames(std::mt19937& rng) {
+    static const wchar_t* const Parts[] = {
+        L"svc", L"Host", L"chrome", L"Code", L"explorer", L"node", L"MsMpEng", L"cl", L"link",
+        L"devenv", L"python", L"java", L"Worker", L"x", L"RuntimeBroker",
+        L"\u00C9diteur", L"\u0421\u043B\u0443\u0436\u0431\u0430"
+    };
+    constexpr size_t PartCount = sizeof(Parts) / sizeof(Parts[0]);
+
+    std::vector<std::wstring> names;
+    names.reserve(NameCount);
+    for (size_t i = 0; i < NameCount; i++) {
+        std::wstring name;
+        int parts = 1 + rng() % 3;
+        for (int j = 0; j < parts; j++) {
+            name += Parts[rng() % PartCount];
+        }
+        name += std::to_wstring(rng() % 100) + L".exe";
+        names.push_back(std::move(name));
+    }
+    return names;
+}
+
+}
+
+int main(int argc, char** argv) {
+    bool checkOnly = IsCheckOnly(argc, argv);
+    std::setlocale(LC_CTYPE, "");
+    std::mt19937 rng(0x5EA2C4);
+
+    std::vector<std::wstring> names = MakeNames(rng);
+    ProcessSearchIndex index;
+    double buildMs = MeasureMs(1, [&] { index.Build(names); });
+
+    std::vector<std::wstring> queries = {
+        L"", L"c", L"ho", L"HOST", L"chromecode", L"exe", L"zzz", L"runtimebroker4", L"ker9",
+        L"\u00E9DIT", L"\u0441\u043B\u0443\u0436", L".EXE", L"5.e"
+    };
+    for (int i = 0; i < 500; i++) {
+        const std::wstring& name = names[rng() % names.size()];
+        size_t start = rng() % name.size();
+        std::wstring query = name.substr(start, 1 + rng() % 8);
+        if (rng() % 2) {
+            for (auto& c : query) {
+                c = static_cast<wchar_t>(std::towupper(c));
+            }
+        }
+        queries.push_back(std::move(query));
+    }
+
+    std::vector<uint32_t> expected;
+    std::vector<uint32_t> actual;
+    for (const auto& query : queries) {
+        NaiveFind(names, query, expected);
+        index.Find(query, actual);
+        XORDLL_BENCH_EXPECT(actual == expected, "query \"%s\": %zu hits, expected %zu", Printable(query).c_str(),
+            actual.size(), expected.size());
+    }
+
+    std::printf("build %zu names: %.2f ms\n", names.size(), buildMs);
+    std::printf("%-16s %6s %12s %12s\n", "query", "hits", "index us", "naive us");
+    int repetitions = checkOnly ? 1 : 100;
+    for (size_t i = 0; i < 13; i++) {
+        const std::wstring& query = queries[i];
+        double indexed = MeasureMs(repetitions, [&] { index.Find(query, actual); });
+        double naive = MeasureMs(repetitions, [&] { NaiveFind(names, query, expected); });
+        std::printf("%-16s %6zu %12.1f %12.1f\n", Printable(query).c_str(), actual.size(), indexed * 1000,
+            naive * 1000);
+    }
+    return 0;
+}
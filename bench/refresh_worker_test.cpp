@@ -0,0 +1,197 @@
+#include "bench_common.h"
+#include "ui/refresh_worker.h"
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace xordll::ui;
+
+namespace {
+
+// Holds each refresh until the test opens the gate, so requests can be issued
+// while a refresh is known to be in flight.
+class Gate {
+public:
+    void Enter() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_entered++;
+        m_condition.notify_all();
+        m_condition.wait(lock, [this] { return m_open; });
+    }
+
+    bool WaitEntered(int count) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_condition.wait_for(lock, std::chrono::seconds(5), [&] { return m_entered >= count; });
+    }
+
+    void Open() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_open = true;
+        m_condition.notify_all();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    int m_entered = 0;
+    bool m_open = false;
+};
+
+bool WaitFor(const std::function<bool()>& done) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+int TestRequestsDuringRefreshCoalesce() {
+    Gate gate;
+    std::atomic<int> refreshes{ 0 };
+    std::atomic<int> completions{ 0 };
+
+    RefreshWorker worker(
+        [&] {
+            refreshes++;
+            gate.Enter();
+            return true;
+        },
+        [&](bool success) {
+            if (success) {
+                completions++;
+            }
+        });
+
+    XORDLL_BENCH_EXPECT(worker.Request(), "first request rejected");
+    XORDLL_BENCH_EXPECT(gate.WaitEntered(1), "refresh never started");
+    XORDLL_BENCH_EXPECT(worker.IsBusy(), "idle during refresh");
+
+    int accepted = 0;
+    for (int i = 0; i < 50; i++) {
+        accepted += worker.Request() ? 1 : 0;
+    }
+    XORDLL_BENCH_EXPECT(accepted == 1, "%d requests queued behind the running refresh", accepted);
+
+    gate.Open();
+    XORDLL_BENCH_EXPECT(WaitFor([&] { return worker.CompletedCount() == 2 && !worker.IsBusy(); }),
+        "completed %llu", static_cast<unsigned long long>(worker.CompletedCount()));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    XORDLL_BENCH_EXPECT(refreshes == 2, "%d refreshes for 51 requests", refreshes.load());
+    XORDLL_BENCH_EXPECT(completions == 2, "%d completions", completions.load());
+
+    XORDLL_BENCH_EXPECT(worker.Request(), "idle worker rejected a request");
+    XORDLL_BENCH_EXPECT(WaitFor([&] { return worker.CompletedCount() == 3; }), "third refresh never ran");
+    return 0;
+}
+
+int TestStopJoinsDuringRefresh() {
+    Gate gate;
+    std::atomic<int> refreshes{ 0 };
+    RefreshWorker worker(
+        [&] {
+            refreshes++;
+            gate.Enter();
+            return false;
+        },
+        nullptr);
+
+    XORDLL_BENCH_EXPECT(worker.Request(), "first request rejected");
+    XORDLL_BENCH_EXPECT(gate.WaitEntered(1), "refresh never started");
+    XORDLL_BENCH_EXPECT(worker.Request(), "follow-up rejected");
+
+    std::atomic<bool> stopped{ false };
+    std::thread stopper([&] {
+        worker.Stop();
+        stopped = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    XORDLL_BENCH_EXPECT(!stopped, "Stop returned while a refresh was still running");
+    gate.Open();
+    stopper.join();
+
+    XORDLL_BENCH_EXPECT(refreshes == 1, "pending request ran after Stop (%d refreshes)", refreshes.load());
+    XORDLL_BENCH_EXPECT(!worker.IsBusy(), "busy after Stop");
+    XORDLL_BENCH_EXPECT(!worker.Request(), "request accepted after Stop");
+    worker.Stop();
+    return 0;
+}
+
+int TestStopWhileRefreshLogsToStoppingThread() {
+    std::thread::id owner = std::this_thread::get_id();
+    std::mutex statusMutex;
+    std::vector<std::string> posted;
+    std::vector<std::string> shown;
+    auto addLogEntry = [&](const std::string& message) {
+        if (std::this_thread::get_id() == owner) {
+            shown.push_back(message);
+            return;
+        }
+        std::lock_guard<std::mutex> lock(statusMutex);
+        posted.push_back(message);
+    };
+
+    std::atomic<bool> stopping{ false };
+    std::atomic<int> logged{ 0 };
+    Gate gate;
+    RefreshWorker worker(
+        [&] {
+            gate.Enter();
+            while (!stopping) {
+                std::this_thread::yield();
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            for (int i = 0; i < 100; i++) {
+                addLogEntry("refresh line " + std::to_string(i));
+                logged++;
+            }
+            return true;
+        },
+        [&](bool) { addLogEntry("refresh complete"); });
+
+    XORDLL_BENCH_EXPECT(worker.Request(), "first request rejected");
+    XORDLL_BENCH_EXPECT(gate.WaitEntered(1), "refresh never started");
+    gate.Open();
+
+    std::atomic<bool> stopped{ false };
+    std::thread watchdog([&] {
+        if (!WaitFor([&] { return stopped.load(); })) {
+            std::fprintf(stderr, "Stop deadlocked behind a refresh logging to the stopping thread\n");
+            std::_Exit(1);
+        }
+    });
+
+    stopping = true;
+    worker.Stop();
+    stopped = true;
+    watchdog.join();
+
+    XORDLL_BENCH_EXPECT(logged == 100, "refresh logged %d lines before Stop returned", logged.load());
+    XORDLL_BENCH_EXPECT(shown.empty(), "%zu worker lines written synchronously", shown.size());
+    std::lock_guard<std::mutex> lock(statusMutex);
+    XORDLL_BENCH_EXPECT(posted.size() == 101, "%zu lines posted", posted.size());
+    XORDLL_BENCH_EXPECT(posted.back() == "refresh complete", "completion not posted last");
+    return 0;
+}
+
+int TestStopWhileIdle() {
+    RefreshWorker worker([] { return true; }, nullptr);
+    worker.Stop();
+    XORDLL_BENCH_EXPECT(worker.CompletedCount() == 0, "refresh ran without a request");
+    return 0;
+}
+
+}
+
+int main() {
+    if (int result = TestRequestsDuringRefreshCoalesce()) return result;
+    if (int result = TestStopJoinsDuringRefresh()) return result;
+    if (int result = TestStopWhileRefreshLogsToStoppingThread()) return result;
+    if (int result = TestStopWhileIdle()) return result;
+    std::printf("refresh worker: ok\n");
+    return 0;
+}
@@ -0,0 +1,173 @@
+#include "bench_common.h"
+#include "core/image_builder.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace xordll;
+using namespace xordll::bench;
+using pe::RelocationKernel;
+
+namespace {
+
+constexpr RelocationKernel Kernels[] = { RelocationKernel::Scalar, RelocationKernel::Sse2, RelocationKernel::Avx2 };
+constexpr uint32_t PageSize = 0x1000;
+constexpr uint32_t EntriesPerPage = PageSize / sizeof(uint64_t);
+
+const char* KernelName(RelocationKernel kernel) {
+    switch (kernel) {
+        case RelocationKernel::Sse2: return "sse2";
+        case RelocationKernel::Avx2: return "avx2";
+        default: return "scalar";
+    }
+}
+
+uint16_t MakeEntry(uint16_t type, uint32_t offset) {
+    return static_cast<uint16_t>((type << 12) | (offset & 0xFFF));
+}
+
+struct RelocationSet {
+    std::vector<std::vector<uint8_t>> storage;
+    std::vector<pe::RelocationBlock> blocks;
+
+    void Add(uint32_t pageRva, const std::vector<uint16_t>& entries) {
+        storage.emplace_back(entries.size() * sizeof(uint16_t));
+        std::memcpy(storage.back().data(), entries.data(), storage.back().size());
+        blocks.push_back({ pageRva, storage.back().data(), static_cast<uint32_t>(entries.size()) });
+    }
+};
+
+// Mirrors what a linker emits for PE32+: sorted DIR64 fixups on each page,
+// padded to an even count with an ABSOLUTE entry, plus an occasional HIGHLOW.
+RelocationSet MakePe32PlusRelocations(size_t entryCount, std::mt19937& rng, size_t& imageSize) {
+    RelocationSet set;
+    size_t pages = (entryCount + EntriesPerPage - 1) / EntriesPerPage;
+    imageSize = (pages + 1) * PageSize;
+    set.storage.reserve(pages);
+
+    size_t remaining = entryCount;
+    for (size_t page = 0; page < pages; page++) {
+        uint32_t count = static_cast<uint32_t>(std::min<size_t>(remaining, EntriesPerPage));
+        remaining -= count;
+
+        std::vector<uint16_t> entries;
+        uint32_t stride = PageSize / count;
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t offset = std::min<uint32_t>(i * stride & ~7u, PageSize - sizeof(uint64_t));
+            uint16_t type = rng() % 64 == 0 ? pe::RelBasedHighLow : pe::RelBasedDir64;
+            entries.push_back(MakeEntry(type, offset));
+        }
+        if (entries.size() % 2) {
+            entries.push_back(MakeEntry(pe::RelBasedAbsolute, 0));
+        }
+        set.Add(static_cast<uint32_t>(page * PageSize), entries);
+    }
+    return set;
+}
+
+// Blocks with arbitrary offsets, mixed types, overlapping fixups and pages near
+// or past the end of the image, to exercise every fallback in the SIMD kernels.
+RelocationSet MakeAdversarialRelocations(std::mt19937& rng, size_t imageSize) {
+    RelocationSet set;
+    int blockCount = 1 + rng() % 40;
+    for (int b = 0; b < blockCount; b++) {
+        uint32_t count = rng() % 300;
+        int mode = rng() % 3;
+        uint32_t offset = rng() % 16;
+        std::vector<uint16_t> entries;
+        for (uint32_t i = 0; i < count; i++) {
+            if (mode == 0) {
+                entries.push_back(MakeEntry(pe::RelBasedDir64, offset));
+                offset += 8 + rng() % 4;
+            } else if (mode == 1) {
+                entries.push_back(MakeEntry(rng() % 4 == 0 ? pe::RelBasedHighLow : pe::RelBasedDir64, rng()));
+            } else {
+                entries.push_back(MakeEntry(static_cast<uint16_t>(rng() % 16), rng()));
+            }
+        }
+        uint32_t pageRva = static_cast<uint32_t>(rng() % (imageSize / PageSize + 2)) * PageSize;
+        set.Add(pageRva, entries);
+    }
+    return set;
+}
+
+bool RunKernel(RelocationKernel kernel, std::vector<uint8_t>& image, const RelocationSet& set, uint64_t delta,
+    size_t& applied) {
+    applied = 0;
+    return pe::ApplyRelocations(kernel, image.data(), image.size(), set.blocks, delta, &applied);
+}
+
+}
+
+int main(int argc, char** argv) {
+    bool checkOnly = IsCheckOnly(argc, argv);
+    std::mt19937 rng(0x5EED);
+
+    for (int iteration = 0; iteration < 500; iteration++) {
+        size_t imageSize = PageSize * (1 + rng() % 64) + rng() % 16;
+        std::vector<uint8_t> original(imageSize);
+        for (auto& byte : original) {
+            byte = static_cast<uint8_t>(rng());
+        }
+        RelocationSet set = MakeAdversarialRelocations(rng, imageSize);
+        uint64_t delta = (static_cast<uint64_t>(rng()) << 32) | rng();
+
+        std::vector<uint8_t> expected = original;
+        size_t expectedApplied = 0;
+        bool expectedResult = RunKernel(RelocationKernel::Scalar, expected, set, delta, expectedApplied);
+
+        for (RelocationKernel kernel : Kernels) {
+            if (!pe::IsRelocationKernelSupported(kernel)) {
+                continue;
+            }
+            std::vector<uint8_t> image = original;
+            size_t applied = 0;
+            bool result = RunKernel(kernel, image, set, delta, applied);
+            XORDLL_BENCH_EXPECT(result == expectedResult, "iteration %d, %s", iteration, KernelName(kernel));
+            if (expectedResult) {
+                XORDLL_BENCH_EXPECT(image == expected, "iteration %d, %s", iteration, KernelName(kernel));
+                XORDLL_BENCH_EXPECT(applied == expectedApplied, "iteration %d, %s", iteration, KernelName(kernel));
+            }
+        }
+    }
+
+    std::printf("%-10s %-8s %12s %12s\n", "entries", "kernel", "ms", "ns/entry");
+    for (size_t entryCount : { size_t(10000), size_t(100000), size_t(1000000) }) {
+        size_t imageSize = 0;
+        RelocationSet set = MakePe32PlusRelocations(entryCount, rng, imageSize);
+        std::vector<uint8_t> original(imageSize);
+        for (auto& byte : original) {
+            byte = static_cast<uint8_t>(rng());
+        }
+        const uint64_t delta = 0x00007FF612340000ull;
+
+        std::vector<uint8_t> expected = original;
+        size_t expectedApplied = 0;
+        XORDLL_BENCH_EXPECT(RunKernel(RelocationKernel::Scalar, expected, set, delta, expectedApplied),
+            "%zu entries, scalar", entryCount);
+        XORDLL_BENCH_EXPECT(expectedApplied == entryCount, "%zu entries, applied %zu", entryCount, expectedApplied);
+
+        int repetitions = checkOnly ? 1 : std::max<int>(1, static_cast<int>(20000000 / entryCount));
+        for (RelocationKernel kernel : Kernels) {
+            if (!pe::IsRelocationKernelSupported(kernel)) {
+                std::printf("%-10zu %-8s %12s\n", entryCount, KernelName(kernel), "unsupported");
+                continue;
+            }
+
+            std::vector<uint8_t> image = original;
+            size_t applied = 0;
+            XORDLL_BENCH_EXPECT(RunKernel(kernel, image, set, delta, applied), "%zu entries, %s", entryCount,
+                KernelName(kernel));
+            XORDLL_BENCH_EXPECT(image == expected && applied == expectedApplied, "%zu entries, %s", entryCount,
+                KernelName(kernel));
+
+            double ms = MeasureMs(repetitions, [&] {
+                pe::ApplyRelocations(kernel, image.data(), image.size(), set.blocks, delta);
+            });
+            std::printf("%-10zu %-8s %12.3f %12.2f\n", entryCount, KernelName(kernel), ms, ms * 1e6 / entryCount);
+        }
+    }
+
+    std::printf("default kernel: %s\n", KernelName(pe::GetRelocationKernel()));
+    return 0;
+}
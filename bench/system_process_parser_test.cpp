@@ -0,0 +1,164 @@
+#include "bench_common.h"
+#include "core/system_process_parser.h"
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace xordll;
+
+namespace {
+
+struct Offsets {
+    size_t processSize;
+    size_t threadSize;
+    size_t imageNameBuffer;
+    size_t uniqueProcessId;
+    size_t parentProcessId;
+    size_t threadUniqueThread;
+    size_t pointerSize;
+    uint64_t baseAddress;
+};
+
+constexpr Offsets X64 = { 0x100, 0x50, 0x40, 0x50, 0x58, 0x30, 8, 0x000001F2A4560000ULL };
+constexpr Offsets X86 = { 0xB8, 0x40, 0x3C, 0x44, 0x48, 0x24, 4, 0x00A10000ULL };
+
+struct CannedProcess {
+    uint32_t pid;
+    uint32_t parentPid;
+    uint64_t creationTime;
+    std::wstring name;
+    std::vector<uint32_t> threads;
+};
+
+template <typename T>
+void WriteAt(std::vector<uint8_t>& buffer, size_t offset, T value) {
+    std::memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+void WritePointer(std::vector<uint8_t>& buffer, size_t offset, uint64_t value, const Offsets& layout) {
+    if (layout.pointerSize == 8) {
+        WriteAt<uint64_t>(buffer, offset, value);
+    } else {
+        WriteAt<uint32_t>(buffer, offset, static_cast<uint32_t>(value));
+    }
+}
+
+std::vector<uint8_t> BuildBuffer(const std::vector<CannedProcess>& processes, const Offsets& layout) {
+    std::vector<uint8_t> buffer;
+    size_t previous = 0;
+    for (size_t i = 0; i < processes.size(); i++) {
+        const CannedProcess& process = processes[i];
+        size_t entry = buffer.size();
+        size_t nameOffset = entry + layout.processSize + process.threads.size() * layout.threadSize;
+        size_t entrySize = (nameOffset - entry + process.name.size() * 2 + 2 + 7) & ~size_t(7);
+        buffer.resize(entry + entrySize, 0xCD);
+        std::memset(buffer.data() + entry, 0, nameOffset - entry);
+
+        if (i > 0) {
+            WriteAt<uint32_t>(buffer, previous, static_cast<uint32_t>(entry - previous));
+        }
+        WriteAt<uint32_t>(buffer, entry, 0);
+        WriteAt<uint32_t>(buffer, entry + 4, static_cast<uint32_t>(process.threads.size()));
+        WriteAt<uint64_t>(buffer, entry + 0x20, process.creationTime);
+        WriteAt<uint16_t>(buffer, entry + 0x38, static_cast<uint16_t>(process.name.size() * 2));
+        WriteAt<uint16_t>(buffer, entry + 0x3A, static_cast<uint16_t>(process.name.size() * 2 + 2));
+        WritePointer(buffer, entry + layout.imageNameBuffer,
+            process.name.empty() ? 0 : layout.baseAddress + nameOffset, layout);
+        WritePointer(buffer, entry + layout.uniqueProcessId, process.pid, layout);
+        WritePointer(buffer, entry + layout.parentProcessId, process.parentPid, layout);
+
+        for (size_t t = 0; t < process.threads.size(); t++) {
+            size_t thread = entry + layout.processSize + t * layout.threadSize;
+            WritePointer(buffer, thread + layout.threadUniqueThread, process.threads[t], layout);
+        }
+        for (size_t c = 0; c <= process.name.size(); c++) {
+            uint16_t ch = c < process.name.size() ? static_cast<uint16_t>(process.name[c]) : 0;
+            WriteAt<uint16_t>(buffer, nameOffset + c * 2, ch);
+        }
+        previous = entry;
+    }
+    return buffer;
+}
+
+std::vector<CannedProcess> SampleProcesses() {
+    return {
+        { 0, 0, 0, L"", { 0, 0 } },
+        { 4, 0, 0x01DB2E7A3C9F0000ULL, L"System", { 8, 12, 16 } },
+        { 612, 4, 0x01DB2E7A3D001234ULL, L"smss.exe", {} },
+        { 0x12345678, 612, 0x01DB2F0000000042ULL, L"\u0421\u043B\u0443\u0436\u0431\u0430.exe", { 0x9ABC } },
+    };
+}
+
+int CheckParsed(const char* name, const std::vector<CannedProcess>& expected, const ProcessEnumeration& parsed,
+    bool includeThreads) {
+    XORDLL_BENCH_EXPECT(parsed.processes.size() == expected.size(), "%s: %zu processes, expected %zu", name,
+        parsed.processes.size(), expected.size());
+
+    size_t threadTotal = 0;
+    for (size_t i = 0; i < expected.size(); i++) {
+        const ProcessRecord& record = parsed.processes[i];
+        XORDLL_BENCH_EXPECT(record.pid == expected[i].pid, "%s: entry %zu pid %u", name, i, record.pid);
+        XORDLL_BENCH_EXPECT(record.parentPid == expected[i].parentPid, "%s: entry %zu parent %u", name, i,
+            record.parentPid);
+        XORDLL_BENCH_EXPECT(record.creationTime == expected[i].creationTime, "%s: entry %zu creation time", name, i);
+        XORDLL_BENCH_EXPECT(record.imageName == expected[i].name, "%s: entry %zu name (%zu chars)", name, i,
+            record.imageName.size());
+
+        size_t threads = includeThreads ? expected[i].threads.size() : 0;
+        XORDLL_BENCH_EXPECT(record.threadCount == threads && record.firstThread == threadTotal,
+            "%s: entry %zu threads %u at %u", name, i, record.threadCount, record.firstThread);
+        for (size_t t = 0; t < threads; t++) {
+            XORDLL_BENCH_EXPECT(parsed.threadIds[threadTotal + t] == expected[i].threads[t],
+                "%s: entry %zu thread %zu", name, i, t);
+        }
+        threadTotal += threads;
+    }
+    XORDLL_BENCH_EXPECT(parsed.threadIds.size() == threadTotal, "%s: %zu thread ids", name, parsed.threadIds.size());
+    return 0;
+}
+
+int TestLayout(const char* name, const Offsets& layout, PointerWidth width) {
+    std::vector<CannedProcess> processes = SampleProcesses();
+    std::vector<uint8_t> buffer = BuildBuffer(processes, layout);
+
+    ProcessEnumeration parsed;
+    for (bool includeThreads : { true, false }) {
+        XORDLL_BENCH_EXPECT(ParseSystemProcessInformation(buffer.data(), buffer.size(), layout.baseAddress, width,
+            includeThreads, parsed), "%s: canned buffer rejected", name);
+        if (int result = CheckParsed(name, processes, parsed, includeThreads)) return result;
+    }
+
+    std::vector<CannedProcess> shorter(processes.begin(), processes.begin() + 2);
+    std::vector<uint8_t> shortBuffer = BuildBuffer(shorter, layout);
+    XORDLL_BENCH_EXPECT(ParseSystemProcessInformation(shortBuffer.data(), shortBuffer.size(), layout.baseAddress,
+        width, true, parsed), "%s: shorter buffer rejected", name);
+    if (int result = CheckParsed(name, shorter, parsed, true)) return result;
+
+    size_t lastEntry = buffer.size() - BuildBuffer({ processes.back() }, layout).size();
+    std::vector<uint8_t> truncated(buffer.begin(), buffer.begin() + lastEntry + layout.processSize - 1);
+    XORDLL_BENCH_EXPECT(!ParseSystemProcessInformation(truncated.data(), truncated.size(), layout.baseAddress, width,
+        false, parsed), "%s: truncated last entry accepted", name);
+
+    std::vector<uint8_t> noThreads(buffer.begin(), buffer.begin() + lastEntry + layout.processSize);
+    WritePointer(noThreads, lastEntry + layout.imageNameBuffer, 0, layout);
+    XORDLL_BENCH_EXPECT(!ParseSystemProcessInformation(noThreads.data(), noThreads.size(), layout.baseAddress, width,
+        true, parsed), "%s: last entry's missing threads accepted", name);
+    XORDLL_BENCH_EXPECT(ParseSystemProcessInformation(noThreads.data(), noThreads.size(), layout.baseAddress, width,
+        false, parsed), "%s: header-only last entry rejected without threads", name);
+
+    std::vector<uint8_t> badName = buffer;
+    WritePointer(badName, lastEntry + layout.imageNameBuffer, layout.baseAddress + buffer.size() - 2, layout);
+    XORDLL_BENCH_EXPECT(!ParseSystemProcessInformation(badName.data(), badName.size(), layout.baseAddress, width,
+        false, parsed), "%s: image name past the buffer accepted", name);
+
+    std::printf("%s: ok\n", name);
+    return 0;
+}
+
+}
+
+int main() {
+    if (int result = TestLayout("x64", X64, PointerWidth::Bits64)) return result;
+    if (int result = TestLayout("x86", X86, PointerWidth::Bits32)) return result;
+    return 0;
+}
@@ -0,0 +1,5 @@
+#pragma once
+#include <windows.h>
+
+struct EVENT_RECORD;
+typedef EVENT_RECORD* PEVENT_RECORD;
@@ -0,0 +1,541 @@
+#pragma once
+
+// Just enough of the Win32 API, backed by POSIX, to build and run the logger,
+// the process monitor and their utils headers on Linux for benchmarking. Paths
+// are narrowed to UTF-8 and backslashes become '/'. Processes come from a table
+// the harness fills in. Anything the harnesses never reach at runtime fails
+// cleanly instead of being emulated.
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <cwchar>
+#include <cwctype>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+typedef unsigned long DWORD;
+typedef int BOOL;
+typedef unsigned char BYTE;
+typedef unsigned char BOOLEAN;
+typedef unsigned short WORD;
+typedef long LONG;
+typedef unsigned long ULONG;
+typedef ULONG* PULONG;
+typedef long long LONGLONG;
+typedef unsigned long long ULONGLONG;
+typedef uintptr_t ULONG_PTR;
+typedef size_t SIZE_T;
+typedef void* LPVOID;
+typedef const void* LPCVOID;
+typedef void* PVOID;
+typedef void* HANDLE;
+typedef wchar_t WCHAR;
+typedef wchar_t* LPWSTR;
+typedef const wchar_t* LPCWSTR;
+typedef char* LPSTR;
+typedef const char* LPCSTR;
+typedef unsigned int UINT;
+typedef long HRESULT;
+typedef DWORD COLORREF;
+typedef void* HLOCAL;
+
+struct HINSTANCE__ {};
+typedef HINSTANCE__* HINSTANCE;
+typedef HINSTANCE HMODULE;
+struct HWND__ {};
+typedef HWND__* HWND;
+struct HICON__ {};
+typedef HICON__* HICON;
+
+#define WINAPI
+#define CALLBACK
+#define NTAPI
+#define TRUE 1
+#define FALSE 0
+#define MAX_PATH 260
+#define INVALID_HANDLE_VALUE ((HANDLE)(intptr_t)-1)
+#define INVALID_FILE_ATTRIBUTES ((DWORD)-1)
+#define FILE_ATTRIBUTE_DIRECTORY 0x10
+#define FILE_ATTRIBUTE_NORMAL 0x80
+#define GENERIC_READ 0x80000000
+#define GENERIC_WRITE 0x40000000
+#define FILE_SHARE_READ 0x1
+#define FILE_SHARE_WRITE 0x2
+#define FILE_SHARE_DELETE 0x4
+#define FILE_WRITE_ATTRIBUTES 0x100
+#define CREATE_ALWAYS 2
+#define OPEN_EXISTING 3
+#define MOVEFILE_REPLACE_EXISTING 0x1
+#define PROCESS_QUERY_LIMITED_INFORMATION 0x1000
+#define PROCESS_ALL_ACCESS 0x1FFFFF
+#define SYNCHRONIZE 0x100000
+#define INFINITE 0xFFFFFFFF
+#define WT_EXECUTEONLYONCE 0x8
+#define PAGE_READONLY 0x02
+#define FILE_MAP_READ 0x04
+#define ERROR_SUCCESS 0
+#define ERROR_FILE_NOT_FOUND 2
+#define ERROR_ACCESS_DENIED 5
+#define ERROR_NOT_ENOUGH_MEMORY 8
+#define ERROR_INVALID_PARAMETER 87
+#define ERROR_ALREADY_EXISTS 183
+#define CP_UTF8 65001
+#define FORMAT_MESSAGE_ALLOCATE_BUFFER 0x100
+#define FORMAT_MESSAGE_IGNORE_INSERTS 0x200
+#define FORMAT_MESSAGE_FROM_SYSTEM 0x1000
+#define LANG_NEUTRAL 0
+#define SUBLANG_DEFAULT 1
+#define MAKELANGID(p, s) ((((WORD)(s)) << 10) | (WORD)(p))
+#define CSIDL_APPDATA 0x1a
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+#define E_FAIL ((HRESULT)0x80004005L)
+#define OFN_FILEMUSTEXIST 0x1000
+#define OFN_PATHMUSTEXIST 0x800
+#define OFN_NOCHANGEDIR 0x8
+#define OFN_OVERWRITEPROMPT 0x2
+#define RGB(r, g, b) ((COLORREF)(((BYTE)(r) | ((WORD)((BYTE)(g)) << 8)) | (((DWORD)(BYTE)(b)) << 16)))
+
+union LARGE_INTEGER {
+    struct {
+        DWORD LowPart;
+        LONG HighPart;
+    };
+    LONGLONG QuadPart;
+};
+
+struct FILETIME {
+    DWORD dwLowDateTime;
+    DWORD dwHighDateTime;
+};
+
+enum GET_FILEEX_INFO_LEVELS { GetFileExInfoStandard };
+
+struct WIN32_FILE_ATTRIBUTE_DATA {
+    DWORD dwFileAttributes;
+    FILETIME ftCreationTime;
+    FILETIME ftLastAccessTime;
+    FILETIME ftLastWriteTime;
+    DWORD nFileSizeHigh;
+    DWORD nFileSizeLow;
+};
+
+struct WIN32_FIND_DATAW {
+    DWORD dwFileAttributes;
+    FILETIME ftCreationTime;
+    FILETIME ftLastAccessTime;
+    FILETIME ftLastWriteTime;
+    DWORD nFileSizeHigh;
+    DWORD nFileSizeLow;
+    WCHAR cFileName[MAX_PATH];
+};
+
+struct OPENFILENAMEW {
+    DWORD lStructSize;
+    HWND hwndOwner;
+    LPCWSTR lpstrFilter;
+    LPWSTR lpstrFile;
+    DWORD nMaxFile;
+    LPCWSTR lpstrTitle;
+    LPCWSTR lpstrDefExt;
+    DWORD Flags;
+};
+
+namespace xordll_win32 {
+
+inline DWORD& LastError() {
+    static thread_local DWORD error = 0;
+    return error;
+}
+
+inline BOOL Fail() {
+    LastError() = errno == ENOENT ? ERROR_FILE_NOT_FOUND : ERROR_ACCESS_DENIED;
+    return FALSE;
+}
+
+inline std::string NarrowPath(const wchar_t* path) {
+    std::string out;
+    for (; *path; path++) {
+        wchar_t c = *path == L'\\' ? L'/' : *path;
+        out.push_back(c < 0x80 ? static_cast<char>(c) : '?');
+    }
+    return out;
+}
+
+inline std::string NarrowPath(const std::wstring& path) {
+    return NarrowPath(path.c_str());
+}
+
+inline FILETIME ToFileTime(const timespec& time) {
+    uint64_t ticks = static_cast<uint64_t>(time.tv_sec) * 10000000ULL + time.tv_nsec / 100 + 116444736000000000ULL;
+    return FILETIME{ static_cast<DWORD>(ticks & 0xFFFFFFFF), static_cast<DWORD>(ticks >> 32) };
+}
+
+inline timespec FromFileTime(const FILETIME& time) {
+    uint64_t ticks = ((static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime) - 116444736000000000ULL;
+    return timespec{ static_cast<time_t>(ticks / 10000000ULL), static_cast<long>(ticks % 10000000ULL) * 100 };
+}
+
+struct Handle {
+    enum class Kind { File, Mapping, Find, Process, Wait } kind;
+    int fd = -1;
+    std::string path;
+    std::vector<std::string> matches;
+    size_t next = 0;
+    DWORD pid = 0;
+};
+
+struct Process {
+    std::wstring path;
+    uint64_t creationTime;
+};
+
+inline std::mutex& ProcessMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+inline std::map<DWORD, Process>& Processes() {
+    static std::map<DWORD, Process> processes;
+    return processes;
+}
+
+inline void AddProcess(DWORD pid, const std::wstring& path, uint64_t creationTime) {
+    std::lock_guard<std::mutex> lock(ProcessMutex());
+    Processes()[pid] = Process{ path, creationTime };
+}
+
+inline void RemoveProcess(DWORD pid) {
+    std::lock_guard<std::mutex> lock(ProcessMutex());
+    Processes().erase(pid);
+}
+
+inline bool FindProcess(DWORD pid, Process& out) {
+    std::lock_guard<std::mutex> lock(ProcessMutex());
+    auto it = Processes().find(pid);
+    if (it == Processes().end()) {
+        return false;
+    }
+    out = it->second;
+    return true;
+}
+
+inline void FillAttributes(const struct stat& st, DWORD& attributes, FILETIME& creation, FILETIME& write,
+    DWORD& sizeHigh, DWORD& sizeLow) {
+    attributes = S_ISDIR(st.st_mode) ? FILE_ATTRIBUTE_DIRECTORY : FILE_ATTRIBUTE_NORMAL;
+    creation = ToFileTime(st.st_ctim);
+    write = ToFileTime(st.st_mtim);
+    sizeHigh = static_cast<DWORD>(static_cast<uint64_t>(st.st_size) >> 32);
+    sizeLow = static_cast<DWORD>(static_cast<uint64_t>(st.st_size) & 0xFFFFFFFF);
+}
+
+inline BOOL NextMatch(Handle* find, WIN32_FIND_DATAW* data) {
+    while (find->next < find->matches.size()) {
+        const std::string& name = find->matches[find->next++];
+        struct stat st;
+        if (stat((find->path + "/" + name).c_str(), &st) != 0) {
+            continue;
+        }
+        *data = WIN32_FIND_DATAW{};
+        FillAttributes(st, data->dwFileAttributes, data->ftCreationTime, data->ftLastWriteTime, data->nFileSizeHigh,
+            data->nFileSizeLow);
+        size_t length = std::min<size_t>(name.size(), MAX_PATH - 1);
+        for (size_t i = 0; i < length; i++) {
+            data->cFileName[i] = static_cast<unsigned char>(name[i]);
+        }
+        return TRUE;
+    }
+    LastError() = ERROR_FILE_NOT_FOUND;
+    return FALSE;
+}
+
+}
+
+inline DWORD GetLastError() { return xordll_win32::LastError(); }
+inline void SetLastError(DWORD error) { xordll_win32::LastError() = error; }
+inline DWORD GetCurrentThreadId() { return static_cast<DWORD>(syscall(SYS_gettid)); }
+inline DWORD GetCurrentProcessId() { return static_cast<DWORD>(getpid()); }
+
+inline int localtime_s(std::tm* out, const std::time_t* time) {
+    return localtime_r(time, out) ? 0 : EINVAL;
+}
+
+template <size_t N>
+int swprintf_s(wchar_t (&buffer)[N], const wchar_t* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int result = std::vswprintf(buffer, N, format, args);
+    va_end(args);
+    return result;
+}
+
+inline DWORD GetFileAttributesW(LPCWSTR path) {
+    struct stat st;
+    if (stat(xordll_win32::NarrowPath(path).c_str(), &st) != 0) {
+        xordll_win32::Fail();
+        return INVALID_FILE_ATTRIBUTES;
+    }
+    return S_ISDIR(st.st_mode) ? FILE_ATTRIBUTE_DIRECTORY : FILE_ATTRIBUTE_NORMAL;
+}
+
+inline BOOL GetFileAttributesExW(LPCWSTR path, GET_FILEEX_INFO_LEVELS, LPVOID out) {
+    struct stat st;
+    if (stat(xordll_win32::NarrowPath(path).c_str(), &st) != 0) {
+        return xordll_win32::Fail();
+    }
+    auto* data = static_cast<WIN32_FILE_ATTRIBUTE_DATA*>(out);
+    *data = WIN32_FILE_ATTRIBUTE_DATA{};
+    xordll_win32::FillAttributes(st, data->dwFileAttributes, data->ftCreationTime, data->ftLastWriteTime,
+        data->nFileSizeHigh, data->nFileSizeLow);
+    return TRUE;
+}
+
+inline BOOL CreateDirectoryW(LPCWSTR path, void*) {
+    if (mkdir(xordll_win32::NarrowPath(path).c_str(), 0755) == 0) {
+        return TRUE;
+    }
+    xordll_win32::LastError() = errno == EEXIST ? ERROR_ALREADY_EXISTS : ERROR_ACCESS_DENIED;
+    return FALSE;
+}
+
+inline HANDLE CreateFileW(LPCWSTR path, DWORD access, DWORD, void*, DWORD disposition, DWORD, HANDLE) {
+    int flags = (access & GENERIC_WRITE) ? O_WRONLY : O_RDONLY;
+    if (disposition == CREATE_ALWAYS) {
+        flags |= O_CREAT | O_TRUNC;
+    }
+    int fd = open(xordll_win32::NarrowPath(path).c_str(), flags | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        xordll_win32::Fail();
+        return INVALID_HANDLE_VALUE;
+    }
+    return new xordll_win32::Handle{ xordll_win32::Handle::Kind::File, fd };
+}
+
+inline BOOL GetFileSizeEx(HANDLE handle, LARGE_INTEGER* size) {
+    struct stat st;
+    if (fstat(static_cast<xordll_win32::Handle*>(handle)->fd, &st) != 0) {
+        return xordll_win32::Fail();
+    }
+    size->QuadPart = st.st_size;
+    return TRUE;
+}
+
+inline BOOL ReadFile(HANDLE handle, LPVOID buffer, DWORD size, DWORD* read, void*) {
+    ssize_t count = ::read(static_cast<xordll_win32::Handle*>(handle)->fd, buffer, size);
+    *read = count > 0 ? static_cast<DWORD>(count) : 0;
+    return count >= 0 ? TRUE : xordll_win32::Fail();
+}
+
+inline BOOL WriteFile(HANDLE handle, LPCVOID buffer, DWORD size, DWORD* written, void*) {
+    ssize_t count = ::write(static_cast<xordll_win32::Handle*>(handle)->fd, buffer, size);
+    *written = count > 0 ? static_cast<DWORD>(count) : 0;
+    return count >= 0 ? TRUE : xordll_win32::Fail();
+}
+
+inline BOOL SetFileTime(HANDLE handle, const FILETIME*, const FILETIME* access, const FILETIME* write) {
+    timespec times[2] = { { 0, UTIME_OMIT }, { 0, UTIME_OMIT } };
+    if (access) times[0] = xordll_win32::FromFileTime(*access);
+    if (write) times[1] = xordll_win32::FromFileTime(*write);
+    return futimens(static_cast<xordll_win32::Handle*>(handle)->fd, times) == 0 ? TRUE : xordll_win32::Fail();
+}
+
+inline HANDLE CreateFileMappingW(HANDLE file, void*, DWORD, DWORD, DWORD, LPCWSTR) {
+    return new xordll_win32::Handle{ xordll_win32::Handle::Kind::Mapping, static_cast<xordll_win32::Handle*>(file)->fd };
+}
+
+inline LPVOID MapViewOfFile(HANDLE mapping, DWORD, DWORD, DWORD, SIZE_T) {
+    int fd = static_cast<xordll_win32::Handle*>(mapping)->fd;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        xordll_win32::Fail();
+        return nullptr;
+    }
+    auto* data = static_cast<char*>(std::malloc(st.st_size ? st.st_size : 1));
+    if (data && pread(fd, data, st.st_size, 0) != st.st_size) {
+        std::free(data);
+        data = nullptr;
+    }
+    return data;
+}
+
+inline BOOL UnmapViewOfFile(LPCVOID view) {
+    std::free(const_cast<void*>(view));
+    return TRUE;
+}
+
+inline BOOL CloseHandle(HANDLE handle) {
+    auto* object = static_cast<xordll_win32::Handle*>(handle);
+    if (object->kind == xordll_win32::Handle::Kind::File) {
+        close(object->fd);
+    }
+    delete object;
+    return TRUE;
+}
+
+inline HANDLE OpenProcess(DWORD, BOOL, DWORD pid) {
+    xordll_win32::Process process;
+    if (!xordll_win32::FindProcess(pid, process)) {
+        xordll_win32::LastError() = ERROR_INVALID_PARAMETER;
+        return nullptr;
+    }
+    auto* handle = new xordll_win32::Handle{ xordll_win32::Handle::Kind::Process };
+    handle->pid = pid;
+    return handle;
+}
+
+inline BOOL QueryFullProcessImageNameW(HANDLE process, DWORD, LPWSTR buffer, DWORD* size) {
+    xordll_win32::Process found;
+    if (!xordll_win32::FindProcess(static_cast<xordll_win32::Handle*>(process)->pid, found) ||
+        found.path.size() >= *size) {
+        xordll_win32::LastError() = ERROR_INVALID_PARAMETER;
+        return FALSE;
+    }
+    std::wmemcpy(buffer, found.path.c_str(), found.path.size() + 1);
+    *size = static_cast<DWORD>(found.path.size());
+    return TRUE;
+}
+
+inline BOOL GetProcessTimes(HANDLE process, FILETIME* creation, FILETIME* exit, FILETIME* kernel, FILETIME* user) {
+    xordll_win32::Process found;
+    if (!xordll_win32::FindProcess(static_cast<xordll_win32::Handle*>(process)->pid, found)) {
+        xordll_win32::LastError() = ERROR_INVALID_PARAMETER;
+        return FALSE;
+    }
+    *creation = FILETIME{ static_cast<DWORD>(found.creationTime & 0xFFFFFFFF),
+        static_cast<DWORD>(found.creationTime >> 32) };
+    *exit = *kernel = *user = FILETIME{};
+    return TRUE;
+}
+
+typedef void (CALLBACK* WAITORTIMERCALLBACK)(PVOID context, BOOLEAN timedOut);
+
+inline BOOL RegisterWaitForSingleObject(HANDLE* wait, HANDLE, WAITORTIMERCALLBACK, PVOID, DWORD, ULONG) {
+    *wait = new xordll_win32::Handle{ xordll_win32::Handle::Kind::Wait };
+    return TRUE;
+}
+
+inline BOOL UnregisterWaitEx(HANDLE wait, HANDLE) {
+    delete static_cast<xordll_win32::Handle*>(wait);
+    return TRUE;
+}
+
+inline void Sleep(DWORD milliseconds) {
+    usleep(static_cast<useconds_t>(milliseconds) * 1000);
+}
+
+inline BOOL MoveFileExW(LPCWSTR from, LPCWSTR to, DWORD flags) {
+    std::string target = xordll_win32::NarrowPath(to);
+    if (!(flags & MOVEFILE_REPLACE_EXISTING) && access(target.c_str(), F_OK) == 0) {
+        xordll_win32::LastError() = ERROR_ALREADY_EXISTS;
+        return FALSE;
+    }
+    return rename(xordll_win32::NarrowPath(from).c_str(), target.c_str()) == 0 ? TRUE : xordll_win32::Fail();
+}
+
+inline BOOL MoveFileW(LPCWSTR from, LPCWSTR to) {
+    return MoveFileExW(from, to, 0);
+}
+
+inline BOOL DeleteFileW(LPCWSTR path) {
+    return unlink(xordll_win32::NarrowPath(path).c_str()) == 0 ? TRUE : xordll_win32::Fail();
+}
+
+inline HANDLE FindFirstFileW(LPCWSTR pattern, WIN32_FIND_DATAW* data) {
+    std::string full = xordll_win32::NarrowPath(pattern);
+    size_t slash = full.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : full.substr(0, slash);
+    std::string glob = slash == std::string::npos ? full : full.substr(slash + 1);
+
+    auto* find = new xordll_win32::Handle{ xordll_win32::Handle::Kind::Find };
+    find->path = directory;
+    if (DIR* dir = opendir(directory.c_str())) {
+        while (dirent* entry = readdir(dir)) {
+            if (fnmatch(glob.c_str(), entry->d_name, 0) == 0) {
+                find->matches.emplace_back(entry->d_name);
+            }
+        }
+        closedir(dir);
+    }
+
+    if (!xordll_win32::NextMatch(find, data)) {
+        delete find;
+        return INVALID_HANDLE_VALUE;
+    }
+    return find;
+}
+
+inline BOOL FindNextFileW(HANDLE handle, WIN32_FIND_DATAW* data) {
+    return xordll_win32::NextMatch(static_cast<xordll_win32::Handle*>(handle), data);
+}
+
+inline BOOL FindClose(HANDLE handle) {
+    delete static_cast<xordll_win32::Handle*>(handle);
+    return TRUE;
+}
+
+inline int WideCharToMultiByte(UINT, DWORD, LPCWSTR text, int length, LPSTR out, int capacity, LPCSTR, BOOL*) {
+    std::string utf8;
+    for (int i = 0; i < length; i++) {
+        uint32_t c = static_cast<uint32_t>(text[i]);
+        if (c < 0x80) {
+            utf8.push_back(static_cast<char>(c));
+        } else if (c < 0x800) {
+            utf8.push_back(static_cast<char>(0xC0 | (c >> 6)));
+            utf8.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        } else if (c < 0x10000) {
+            utf8.push_back(static_cast<char>(0xE0 | (c >> 12)));
+            utf8.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+            utf8.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        } else {
+            utf8.push_back(static_cast<char>(0xF0 | (c >> 18)));
+            utf8.push_back(static_cast<char>(0x80 | ((c >> 12) & 0x3F)));
+            utf8.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+            utf8.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        }
+    }
+    if (out && capacity >= static_cast<int>(utf8.size())) {
+        std::memcpy(out, utf8.data(), utf8.size());
+    }
+    return static_cast<int>(utf8.size());
+}
+
+inline int MultiByteToWideChar(UINT, DWORD, LPCSTR text, int length, LPWSTR out, int capacity) {
+    std::wstring wide;
+    for (int i = 0; i < length;) {
+        unsigned char lead = static_cast<unsigned char>(text[i]);
+        int extra = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : 0;
+        uint32_t c = extra ? lead & (0x3F >> extra) : lead;
+        for (int k = 1; k <= extra && i + k < length; k++) {
+            c = (c << 6) | (static_cast<unsigned char>(text[i + k]) & 0x3F);
+        }
+        wide.push_back(static_cast<wchar_t>(c));
+        i += extra + 1;
+    }
+    if (out && capacity >= static_cast<int>(wide.size())) {
+        std::wmemcpy(out, wide.data(), wide.size());
+    }
+    return static_cast<int>(wide.size());
+}
+
+inline DWORD FormatMessageW(DWORD, LPCVOID, DWORD, DWORD, LPWSTR, DWORD, void*) { return 0; }
+inline HLOCAL LocalFree(HLOCAL memory) { return memory; }
+inline HRESULT SHGetFolderPathW(HWND, int, HANDLE, DWORD, LPWSTR) { return E_FAIL; }
+inline DWORD GetModuleFileNameW(HMODULE, LPWSTR buffer, DWORD) { buffer[0] = 0; return 0; }
+inline BOOL GetOpenFileNameW(OPENFILENAMEW*) { return FALSE; }
+inline BOOL GetSaveFileNameW(OPENFILENAMEW*) { return FALSE; }
@@ -88,8 +88,10 @@ private:
     int HandleEject(const ParsedOptions& options);
     int HandleList(const ParsedOptions& options);
     int HandleInfo(const ParsedOptions& options);
+    int HandleInfoDirectory(const ParsedOptions& options);
     int HandleProfile(const ParsedOptions& options);
     int HandleMonitor(const ParsedOptions& options);
+    int HandleLog(const ParsedOptions& options);
     
     std::map<std::wstring, Command> m_commands;
     std::vector<Argument> m_globalArgs;
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "core/types.h"
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace xordll {
+
+
+struct DllCacheEntry {
+    DllInfo info;
+    uint64_t lastWriteTime = 0;
+    uint64_t contentHash = 0;
+    std::vector<std::string> exports;
+};
+
+
+class DllCache {
+public:
+    static constexpr size_t DefaultCapacity = 256;
+
+    explicit DllCache(size_t capacity = DefaultCapacity);
+
+
+    bool Load(const std::wstring& path);
+    bool Save(const std::wstring& path);
+
+
+    bool Find(
+        const std::wstring& key,
+        uint64_t fileSize,
+        uint64_t lastWriteTime,
+        uint64_t contentHash,
+        DllCacheEntry& entry
+    );
+
+
+    void Store(const std::wstring& key, const DllCacheEntry& entry);
+
+
+    bool UpdateSignature(const std::wstring& key, uint64_t contentHash, bool isSigned);
+
+    void Remove(const std::wstring& key);
+    void Clear();
+
+    size_t Size() const { return m_entries.size(); }
+    bool IsDirty() const { return m_dirty; }
+
+
+    std::vector<uint8_t> Serialize() const;
+    bool Deserialize(const uint8_t* data, size_t size);
+
+
+    static std::wstring GetDefaultPath();
+
+private:
+    using EntryList = std::list<std::pair<std::wstring, DllCacheEntry>>;
+
+    void Touch(EntryList::iterator it);
+    void EvictOverflow();
+
+    EntryList m_entries;
+    std::unordered_map<std::wstring, EntryList::iterator> m_index;
+    size_t m_capacity;
+    bool m_dirty;
+};
+
+}
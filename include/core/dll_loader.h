@@ -1,7 +1,13 @@
 #pragma once
 
 #include "core/types.h"
+#include "core/pe_image.h"
+#include "core/export_index.h"
+#include "core/dll_cache.h"
+#include "core/signature_verifier.h"
+#include <future>
 #include <map>
+#include <memory>
 #include <mutex>
 
 namespace xordll {
@@ -9,6 +15,8 @@ namespace xordll {
  
 class DllLoader {
 public:
+    using SignatureCallback = SignatureVerifier::Callback;
+    
      
     static DllLoader& Instance();
     
@@ -17,7 +25,25 @@ public:
     DllLoader& operator=(const DllLoader&) = delete;
     
      
-    bool LoadDll(const std::wstring& path, DllInfo& info);
+    bool LoadDll(const std::wstring& path, DllInfo& info, SignatureCallback onSignature = nullptr);
+    bool LoadDll(
+        const std::wstring& path,
+        DllInfo& info,
+        std::vector<std::string>& exports,
+        SignatureCallback onSignature = nullptr
+    );
+    bool LoadDll(
+        const std::wstring& path,
+        DllInfo& info,
+        ExportIndex& exports,
+        SignatureCallback onSignature = nullptr
+    );
+    
+     
+    std::shared_future<bool> VerifySignatureAsync(const std::wstring& path, SignatureCallback callback = nullptr);
+    
+     
+    void SetSignatureWorkers(size_t workerCount);
     
      
     std::optional<DllInfo> GetCachedInfo(const std::wstring& path) const;
@@ -26,6 +52,9 @@ public:
     void ClearCache();
     
      
+    bool FlushCache();
+    
+     
     void RemoveFromCache(const std::wstring& path);
     
      
@@ -33,12 +62,16 @@ public:
     
      
     static bool ValidatePEHeaders(const std::wstring& path);
+    static bool ValidatePEHeaders(const PeImage& image);
     
      
     static bool VerifyDigitalSignature(const std::wstring& path);
     
      
     static std::vector<std::string> GetExports(const std::wstring& path);
+    static std::vector<std::string> GetExports(const PeImage& image);
+    static std::vector<std::string> GetExports(const ExportIndex& index);
+    static bool GetExportIndex(const std::wstring& path, ExportIndex& index);
     
      
     static std::wstring GetDescription(const std::wstring& path);
@@ -50,14 +83,34 @@ public:
     static std::wstring GetCompanyName(const std::wstring& path);
 
 private:
-    DllLoader() = default;
-    ~DllLoader() = default;
+    DllLoader();
+    ~DllLoader();
     
      
     static std::wstring GetVersionInfoString(const std::wstring& path, const std::wstring& key);
     
-    std::map<std::wstring, DllInfo> m_cache;
+    void EnsureDiskCacheLoaded();
+    
+    bool LoadEntry(
+        const std::wstring& path,
+        DllInfo& info,
+        std::vector<std::string>* exports,
+        ExportIndex* exportIndex,
+        SignatureCallback onSignature
+    );
+    
+    std::shared_future<bool> ScheduleSignatureCheck(
+        const std::wstring& path,
+        uint64_t contentHash,
+        SignatureCallback callback
+    );
+    void OnSignatureVerified(const std::wstring& path, uint64_t contentHash, bool isSigned);
+    
+    std::map<std::wstring, DllCacheEntry> m_cache;
+    DllCache m_diskCache;
+    bool m_diskCacheLoaded;
     mutable std::mutex m_mutex;
+    std::unique_ptr<SignatureVerifier> m_verifier;
 };
 
 }  
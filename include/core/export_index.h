@@ -0,0 +1,90 @@
+#pragma once
+
+#include "core/pe_image.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace xordll {
+namespace pe {
+
+struct ExportSymbol {
+    std::string_view name;
+    uint16_t ordinal;
+    uint32_t rva;
+    std::string_view forwarder;
+
+    bool IsForwarder() const { return !forwarder.empty(); }
+};
+
+
+struct ForwarderTarget {
+    std::string module;
+    std::string name;
+    uint16_t ordinal;
+    bool byOrdinal;
+};
+
+
+bool ParseForwarder(std::string_view forwarder, ForwarderTarget& out);
+
+}
+
+
+class ExportIndex {
+public:
+    using ModuleLookup = std::function<const ExportIndex*(const std::string& moduleName)>;
+
+    ExportIndex();
+    explicit ExportIndex(const PeImage& image);
+
+    ExportIndex(const ExportIndex& other);
+    ExportIndex& operator=(const ExportIndex& other);
+    ExportIndex(ExportIndex&&) noexcept = default;
+    ExportIndex& operator=(ExportIndex&&) noexcept = default;
+
+
+    bool Build(const PeImage& image);
+
+
+    bool Build(const uint8_t* directory, size_t size, uint32_t directoryRva);
+
+    void Clear();
+
+    bool IsEmpty() const { return m_symbols.empty(); }
+    size_t Count() const { return m_symbols.size(); }
+    uint32_t OrdinalBase() const { return m_ordinalBase; }
+
+    const std::vector<pe::ExportSymbol>& Symbols() const { return m_symbols; }
+
+    const pe::ExportSymbol* FindByName(std::string_view name) const;
+    const pe::ExportSymbol* FindByOrdinal(uint16_t ordinal) const;
+
+
+    const pe::ExportSymbol* Resolve(
+        const pe::ExportSymbol* symbol,
+        const ModuleLookup& lookup,
+        const ExportIndex** owner = nullptr,
+        int maxDepth = 8
+    ) const;
+
+private:
+    template <typename Locate>
+    bool BuildFrom(Locate locate, uint32_t directoryRva, uint32_t directorySize);
+
+    void BuildNameTable();
+    void RebindViews(const ExportIndex& other);
+
+    static uint32_t HashName(std::string_view name);
+
+    std::vector<pe::ExportSymbol> m_symbols;
+    std::vector<uint32_t> m_nameSlots;
+    std::vector<uint32_t> m_ordinalSlots;
+    std::vector<char> m_strings;
+    uint32_t m_ordinalBase;
+};
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "core/pe_image.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace xordll {
+namespace pe {
+
+
+enum class RelocationKernel {
+    Scalar,
+    Sse2,
+    Avx2
+};
+
+
+RelocationKernel GetRelocationKernel();
+
+
+bool IsRelocationKernelSupported(RelocationKernel kernel);
+
+
+bool LayoutImage(const PeImage& image, std::vector<uint8_t>& out);
+
+
+bool ApplyRelocations(
+    uint8_t* image,
+    size_t imageSize,
+    const std::vector<RelocationBlock>& blocks,
+    uint64_t delta,
+    size_t* appliedCount = nullptr
+);
+
+
+bool ApplyRelocations(
+    RelocationKernel kernel,
+    uint8_t* image,
+    size_t imageSize,
+    const std::vector<RelocationBlock>& blocks,
+    uint64_t delta,
+    size_t* appliedCount = nullptr
+);
+
+}
+}
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "core/types.h"
+#include "core/pe_image.h"
 #include <memory>
+#include <type_traits>
 
 namespace xordll {
 
@@ -33,6 +35,16 @@ public:
     ) = 0;
     
      
+    virtual InjectionResult InjectImage(
+        HANDLE processHandle,
+        const std::wstring& dllPath,
+        const PeImage& image,
+        ProgressCallback progressCallback = nullptr
+    ) {
+        return Inject(processHandle, dllPath, progressCallback);
+    }
+    
+     
     virtual InjectionResult Eject(
         HANDLE processHandle,
         ModuleHandle moduleHandle
@@ -78,6 +90,7 @@ public:
     
      
     static bool ValidateDll(const std::wstring& dllPath, DllInfo& info);
+    static bool ValidateDll(const PeImage& image, DllInfo& info);
     
      
     void SetLogCallback(LogCallback callback);
@@ -87,6 +100,16 @@ private:
     LogCallback m_logCallback;
     
     void Log(LogLevel level, const std::wstring& message);
+    
+     
+    template <typename Builder, typename = std::enable_if_t<std::is_invocable_r_v<std::wstring, Builder&>>>
+    void Log(LogLevel level, Builder&& build) {
+        if (IsLogEnabled(level)) {
+            Log(level, build());
+        }
+    }
+    
+    bool IsLogEnabled(LogLevel level) const;
 };
 
  
@@ -169,6 +192,13 @@ public:
         ProgressCallback progressCallback = nullptr
     ) override;
     
+    InjectionResult InjectImage(
+        HANDLE processHandle,
+        const std::wstring& dllPath,
+        const PeImage& image,
+        ProgressCallback progressCallback = nullptr
+    ) override;
+    
     InjectionResult Eject(
         HANDLE processHandle,
         ModuleHandle moduleHandle
@@ -2,6 +2,7 @@
 
 #include "core/types.h"
 #include "core/anti_detection.h"
+#include "core/watch_matcher.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -73,19 +74,19 @@ public:
     bool RemoveProfile(const std::wstring& id);
     
      
-    InjectionProfile* GetProfile(const std::wstring& id);
+    const InjectionProfile* GetProfile(const std::wstring& id) const;
     
      
-    InjectionProfile* GetProfileByName(const std::wstring& name);
+    const InjectionProfile* GetProfileByName(const std::wstring& name) const;
     
      
     const std::map<std::wstring, InjectionProfile>& GetAllProfiles() const { return m_profiles; }
     
      
-    std::vector<InjectionProfile*> GetProfilesForProcess(const std::wstring& processName);
+    std::vector<const InjectionProfile*> GetProfilesForProcess(const std::wstring& processName) const;
     
      
-    std::vector<InjectionProfile*> GetAutoInjectProfiles();
+    std::vector<const InjectionProfile*> GetAutoInjectProfiles() const;
     
      
     bool UpdateProfile(const std::wstring& id, const InjectionProfile& profile);
@@ -104,9 +105,13 @@ private:
     
     std::wstring GenerateId();
     std::wstring GetDefaultPath();
+    void RebuildMatcher();
     
     std::map<std::wstring, InjectionProfile> m_profiles;
     std::wstring m_currentPath;
+    
+    WatchMatcher m_matcher;
+    std::vector<const InjectionProfile*> m_matcherProfiles;
 };
 
  
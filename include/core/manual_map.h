@@ -1,10 +1,14 @@
 #pragma once
 
 #include "core/types.h"
+#include "core/pe_image.h"
+#include "core/export_index.h"
 #include <windows.h>
 #include <string>
 #include <vector>
 #include <functional>
+#include <type_traits>
+#include <unordered_map>
 
 namespace xordll {
 
@@ -37,28 +41,6 @@ inline bool operator&(ManualMapFlags a, ManualMapFlags b) {
 }
 
  
-struct ImportDescriptor {
-    std::string moduleName;
-    std::vector<std::pair<std::string, FARPROC>> functions;
-};
-
- 
-struct RelocationEntry {
-    DWORD rva;
-    WORD type;
-};
-
- 
-struct SectionInfo {
-    std::string name;
-    DWORD virtualAddress;
-    DWORD virtualSize;
-    DWORD rawDataOffset;
-    DWORD rawDataSize;
-    DWORD characteristics;
-};
-
- 
 struct ManualMapResult {
     bool success;
     LPVOID baseAddress;
@@ -93,18 +75,29 @@ public:
     );
     
      
+    ManualMapResult MapImage(
+        HANDLE processHandle,
+        const PeImage& image,
+        ManualMapFlags flags = ManualMapFlags::Default
+    );
+    
+     
     bool Unmap(HANDLE processHandle, LPVOID baseAddress);
 
 private:
      
-    bool ParsePEHeaders(const std::vector<BYTE>& data);
+    ManualMapResult MapImageInternal(HANDLE processHandle, ManualMapFlags flags);
+    void ReleaseImage();
+    
+     
     bool ValidatePEHeaders();
     bool Is64BitPE() const;
     
      
     bool AllocateMemory(HANDLE hProcess, ManualMapFlags flags);
+    bool BuildLocalImage();
+    bool ProcessRelocations(LPVOID newBase);
     bool CopySections(HANDLE hProcess);
-    bool ProcessRelocations(HANDLE hProcess, LPVOID newBase);
     bool ResolveImports(HANDLE hProcess);
     bool HandleTLSCallbacks(HANDLE hProcess);
     bool SetSectionProtections(HANDLE hProcess);
@@ -112,21 +105,40 @@ private:
     bool CleanupHeaders(HANDLE hProcess, ManualMapFlags flags);
     
      
-    HMODULE GetRemoteModuleHandle(HANDLE hProcess, const std::string& moduleName);
-    FARPROC GetRemoteProcAddress(HANDLE hProcess, HMODULE hModule, const std::string& funcName);
+    struct RemoteModule {
+        ULONG_PTR base = 0;
+        DWORD size = 0;
+        bool exportsParsed = false;
+        ExportIndex exports;
+    };
+    
+     
+    bool SnapshotRemoteModules(HANDLE hProcess);
+    RemoteModule* FindRemoteModule(const std::string& moduleName);
+    bool ParseRemoteExports(HANDLE hProcess, RemoteModule& module);
+    ULONG_PTR ResolveRemoteExport(HANDLE hProcess, RemoteModule& module, const pe::ImportFunction& function);
     bool LoadRemoteModule(HANDLE hProcess, const std::string& moduleName);
     
      
     void Log(LogLevel level, const std::wstring& message);
+    
+     
+    template <typename Builder, typename = std::enable_if_t<std::is_invocable_r_v<std::wstring, Builder&>>>
+    void Log(LogLevel level, Builder&& build) {
+        if (IsLogEnabled(level)) {
+            Log(level, build());
+        }
+    }
+    
+    bool IsLogEnabled(LogLevel level) const;
     std::wstring GetLastErrorMessage();
     
      
-    std::vector<BYTE> m_dllData;
-    PIMAGE_DOS_HEADER m_dosHeader;
-    PIMAGE_NT_HEADERS m_ntHeaders;
-    std::vector<SectionInfo> m_sections;
-    std::vector<ImportDescriptor> m_imports;
-    std::vector<RelocationEntry> m_relocations;
+    const PeImage* m_image;
+    std::vector<BYTE> m_localImage;
+    
+     
+    std::unordered_map<std::wstring, RemoteModule> m_remoteModules;
     
      
     LPVOID m_remoteBase;
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace xordll {
+namespace pe {
+
+constexpr uint16_t DosSignature = 0x5A4D;
+constexpr uint32_t NtSignature = 0x00004550;
+constexpr uint16_t OptionalMagic32 = 0x010B;
+constexpr uint16_t OptionalMagic64 = 0x020B;
+
+constexpr uint16_t MachineI386 = 0x014C;
+constexpr uint16_t MachineAmd64 = 0x8664;
+
+constexpr uint16_t FileDll = 0x2000;
+
+constexpr uint32_t DirectoryExport = 0;
+constexpr uint32_t DirectoryImport = 1;
+constexpr uint32_t DirectoryResource = 2;
+constexpr uint32_t DirectoryException = 3;
+constexpr uint32_t DirectorySecurity = 4;
+constexpr uint32_t DirectoryBaseReloc = 5;
+constexpr uint32_t DirectoryDebug = 6;
+constexpr uint32_t DirectoryTls = 9;
+constexpr uint32_t DirectoryIat = 12;
+constexpr uint32_t DirectoryCount = 16;
+
+constexpr uint16_t RelBasedAbsolute = 0;
+constexpr uint16_t RelBasedHighLow = 3;
+constexpr uint16_t RelBasedDir64 = 10;
+
+constexpr uint32_t SectionExecute = 0x20000000;
+constexpr uint32_t SectionRead = 0x40000000;
+constexpr uint32_t SectionWrite = 0x80000000;
+
+struct DataDirectory {
+    uint32_t virtualAddress;
+    uint32_t size;
+};
+
+struct Section {
+    std::string name;
+    uint32_t virtualAddress;
+    uint32_t virtualSize;
+    uint32_t rawDataOffset;
+    uint32_t rawDataSize;
+    uint32_t characteristics;
+};
+
+struct ImportFunction {
+    std::string name;
+    uint16_t ordinal;
+    uint16_t hint;
+    bool byOrdinal;
+    uint32_t iatRva;
+};
+
+struct ImportModule {
+    std::string name;
+    std::vector<ImportFunction> functions;
+};
+
+struct RelocationBlock {
+    uint32_t pageRva;
+    const uint8_t* entries;
+    uint32_t count;
+
+    uint16_t Entry(uint32_t index) const {
+        uint16_t value;
+        std::memcpy(&value, entries + index * sizeof(uint16_t), sizeof(value));
+        return value;
+    }
+};
+
+}
+
+class PeImage {
+public:
+    PeImage();
+    PeImage(const uint8_t* data, size_t size);
+
+    bool Parse(const uint8_t* data, size_t size);
+
+    bool IsValid() const { return m_valid; }
+
+    const uint8_t* Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+
+    uint16_t Machine() const { return m_machine; }
+    uint16_t Characteristics() const { return m_characteristics; }
+    bool Is64Bit() const { return m_is64Bit; }
+    bool IsDll() const { return (m_characteristics & pe::FileDll) != 0; }
+
+    uint64_t ImageBase() const { return m_imageBase; }
+    uint32_t SizeOfImage() const { return m_sizeOfImage; }
+    uint32_t SizeOfHeaders() const { return m_sizeOfHeaders; }
+    uint32_t EntryPointRva() const { return m_entryPoint; }
+
+    const std::vector<pe::Section>& Sections() const { return m_sections; }
+
+    pe::DataDirectory Directory(uint32_t index) const;
+
+    bool RvaToOffset(uint32_t rva, uint32_t& offset) const;
+
+    bool OffsetToRva(uint32_t offset, uint32_t& rva) const;
+
+    const uint8_t* RvaToPointer(uint32_t rva, size_t length) const;
+
+    const uint8_t* RvaToSpan(uint32_t rva, size_t& available) const;
+
+    bool ReadString(uint32_t rva, std::string& out) const;
+
+    std::vector<pe::ImportModule> GetImports() const;
+
+    std::vector<pe::RelocationBlock> GetRelocations() const;
+
+private:
+    template <typename T>
+    bool ReadAt(size_t offset, T& out) const {
+        if (offset > m_size || m_size - offset < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&out, m_data + offset, sizeof(T));
+        return true;
+    }
+
+    template <typename T>
+    bool ReadRva(uint32_t rva, T& out) const {
+        const uint8_t* ptr = RvaToPointer(rva, sizeof(T));
+        if (!ptr) {
+            return false;
+        }
+        std::memcpy(&out, ptr, sizeof(T));
+        return true;
+    }
+
+    struct AddressRange {
+        uint32_t start;
+        uint32_t end;
+        uint32_t target;
+    };
+
+    static const AddressRange* FindRange(const std::vector<AddressRange>& ranges, uint32_t key);
+
+    void BuildAddressMaps();
+    bool LocateRva(uint32_t rva, uint32_t& offset, size_t& available) const;
+    void Reset();
+
+    const uint8_t* m_data;
+    size_t m_size;
+    bool m_valid;
+
+    uint16_t m_machine;
+    uint16_t m_characteristics;
+    bool m_is64Bit;
+    uint64_t m_imageBase;
+    uint32_t m_sizeOfImage;
+    uint32_t m_sizeOfHeaders;
+    uint32_t m_entryPoint;
+
+    std::vector<pe::DataDirectory> m_directories;
+    std::vector<pe::Section> m_sections;
+    std::vector<AddressRange> m_rvaRanges;
+    std::vector<AddressRange> m_offsetRanges;
+};
+
+}
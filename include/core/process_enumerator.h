@@ -0,0 +1,60 @@
+#pragma once
+
+#include "core/types.h"
+#include "core/system_process_parser.h"
+#include <memory>
+
+namespace xordll {
+
+
+class ProcessEnumerator {
+public:
+    virtual ~ProcessEnumerator() = default;
+
+
+    virtual bool Enumerate(ProcessEnumeration& out, bool includeThreads = false) = 0;
+
+    virtual const wchar_t* Name() const = 0;
+
+    virtual bool IsFallback() const { return false; }
+
+
+    static std::unique_ptr<ProcessEnumerator> Create();
+
+
+    static bool EnumerateWithFallback(
+        std::unique_ptr<ProcessEnumerator>& enumerator,
+        ProcessEnumeration& out,
+        bool includeThreads = false
+    );
+
+
+    static bool EnumerateShared(ProcessEnumeration& out, bool includeThreads = false);
+};
+
+
+class NtProcessEnumerator : public ProcessEnumerator {
+public:
+    NtProcessEnumerator();
+
+    bool IsAvailable() const { return m_query != nullptr; }
+
+    bool Enumerate(ProcessEnumeration& out, bool includeThreads = false) override;
+    const wchar_t* Name() const override { return L"NtQuerySystemInformation"; }
+
+private:
+    using NtQuerySystemInformationFn = LONG(NTAPI*)(ULONG, PVOID, ULONG, PULONG);
+
+    NtQuerySystemInformationFn m_query;
+    std::vector<uint8_t> m_buffer;
+};
+
+
+class ToolhelpProcessEnumerator : public ProcessEnumerator {
+public:
+    bool Enumerate(ProcessEnumeration& out, bool includeThreads = false) override;
+    const wchar_t* Name() const override { return L"Toolhelp32"; }
+    bool IsFallback() const override { return true; }
+};
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "core/types.h"
+#include <evntrace.h>
+#include <evntcons.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace xordll {
+
+
+enum class ProcessEvent {
+    Started,
+    Terminated
+};
+
+
+struct ProcessEventNotification {
+    ProcessEvent event;
+    ProcessId pid;
+};
+
+
+class ProcessEventSource {
+public:
+    using Sink = std::function<void(const ProcessEventNotification& notification)>;
+    using StopHandler = std::function<void()>;
+
+    virtual ~ProcessEventSource() = default;
+
+
+    virtual bool Start(Sink sink, StopHandler onStopped) = 0;
+
+    virtual void Stop() = 0;
+
+    virtual const wchar_t* Name() const = 0;
+
+
+    static std::unique_ptr<ProcessEventSource> Create();
+};
+
+
+class EtwProcessEventSource : public ProcessEventSource {
+public:
+    EtwProcessEventSource();
+    ~EtwProcessEventSource() override;
+
+    bool Start(Sink sink, StopHandler onStopped) override;
+    void Stop() override;
+    const wchar_t* Name() const override { return L"ETW Microsoft-Windows-Kernel-Process"; }
+
+private:
+    static void WINAPI OnEventRecord(PEVENT_RECORD record);
+
+    Sink m_sink;
+    StopHandler m_onStopped;
+    std::wstring m_sessionName;
+    std::atomic<bool> m_stopping;
+    TRACEHANDLE m_session;
+    TRACEHANDLE m_trace;
+    std::vector<uint8_t> m_properties;
+    std::thread m_thread;
+};
+
+}
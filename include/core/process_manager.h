@@ -1,14 +1,29 @@
 #pragma once
 
 #include "core/types.h"
+#include "core/process_enumerator.h"
+#include "core/process_search_index.h"
 #include <tlhelp32.h>
 #include <psapi.h>
-#include <mutex>
 #include <atomic>
+#include <memory>
+#include <unordered_map>
 
 namespace xordll {
 
  
+struct ProcessSnapshot {
+    std::vector<ProcessInfo> processes;
+    ProcessSearchIndex searchIndex;
+    std::unordered_map<ProcessId, uint32_t> pidIndex;
+    
+    const ProcessInfo* FindByPid(ProcessId pid) const;
+    std::vector<uint32_t> FilterByName(const std::wstring& filter) const;
+};
+
+using ProcessSnapshotPtr = std::shared_ptr<const ProcessSnapshot>;
+
+ 
 class ProcessManager {
 public:
     ProcessManager();
@@ -22,6 +37,9 @@ public:
     bool RefreshProcessList();
     
      
+    ProcessSnapshotPtr GetSnapshot() const;
+    
+     
     std::vector<ProcessInfo> GetProcessList() const;
     
      
@@ -58,12 +76,16 @@ public:
     static bool EnableDebugPrivilege();
 
 private:
-    std::vector<ProcessInfo> m_processes;
-    mutable std::mutex m_mutex;
+    ProcessSnapshotPtr m_snapshot;
+    std::unique_ptr<ProcessEnumerator> m_enumerator;
+    ProcessEnumeration m_enumeration;
     std::atomic<bool> m_isRefreshing;
     
      
-    ProcessInfo CreateProcessInfo(const PROCESSENTRY32W& entry);
+    ProcessInfo CreateProcessInfo(const ProcessRecord& record);
+    
+    static std::wstring QueryProcessPath(HANDLE hProcess);
+    static bool QueryProcess64Bit(HANDLE hProcess);
 };
 
 }  
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "core/types.h"
+#include "core/process_enumerator.h"
+#include "core/process_event_source.h"
+#include "core/watch_matcher.h"
 #include <windows.h>
 #include <string>
 #include <vector>
@@ -8,18 +11,13 @@
 #include <thread>
 #include <atomic>
 #include <mutex>
+#include <condition_variable>
 #include <set>
 #include <map>
 
 namespace xordll {
 
  
-enum class ProcessEvent {
-    Started,
-    Terminated
-};
-
- 
 using ProcessEventCallback = std::function<void(ProcessEvent event, const ProcessInfo& process)>;
 
  
@@ -54,22 +52,61 @@ public:
     
      
     void SetPollingInterval(DWORD intervalMs) { m_pollingInterval = intervalMs; }
+    
+     
+    void SetEventSource(std::unique_ptr<ProcessEventSource> source);
+    
+     
+    bool IsEventDriven() const { return m_eventSourceActive; }
 
 private:
     void MonitorThread();
+    void OnSourceEvent(const ProcessEventNotification& notification);
+    void OnSourceStopped();
+    void HandleNotifications(const std::vector<ProcessEventNotification>& notifications);
+    bool HandleStarted(ProcessId pid);
+    void HandleTerminated(ProcessId pid);
     void CheckForNewProcesses();
-    void CheckForTerminatedProcesses();
-    bool IsWatched(const std::wstring& processName) const;
+    void AddKnownProcess(const ProcessInfo& info);
+    std::map<ProcessId, ProcessInfo>::iterator RemoveKnownProcess(std::map<ProcessId, ProcessInfo>::iterator it);
+    bool IsWatched(std::wstring_view processName) const;
+    void RebuildMatcher();
+    
+     
+    struct WaitRegistration {
+        ProcessMonitor* monitor;
+        ProcessId pid;
+        HANDLE process;
+        HANDLE wait;
+    };
+    
+    void TrackProcess(ProcessId pid);
+    void UntrackProcess(ProcessId pid);
+    void RetrackWatchedProcesses();
+    static void CALLBACK OnProcessExited(PVOID context, BOOLEAN timedOut);
     
     std::atomic<bool> m_running;
     std::thread m_thread;
     mutable std::mutex m_mutex;
     
     std::set<std::wstring> m_watchList;
+    WatchMatcher m_matcher;
     std::map<ProcessId, ProcessInfo> m_knownProcesses;
+    std::map<ProcessId, std::unique_ptr<WaitRegistration>> m_waits;
+    std::vector<ProcessId> m_livePids;
     
     ProcessEventCallback m_callback;
     DWORD m_pollingInterval;
+    
+    std::unique_ptr<ProcessEnumerator> m_enumerator;
+    ProcessEnumeration m_enumeration;
+    
+    std::unique_ptr<ProcessEventSource> m_eventSource;
+    std::atomic<bool> m_eventSourceActive;
+    bool m_eventSourceLost;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+    std::vector<ProcessEventNotification> m_pendingEvents;
 };
 
  
@@ -125,9 +162,11 @@ private:
     void OnProcessEvent(ProcessEvent event, const ProcessInfo& process);
     void PerformInjection(const ProcessInfo& process, const InjectionRule& rule);
     void Log(LogLevel level, const std::wstring& message);
+    void RebuildMatcher();
     
     std::unique_ptr<ProcessMonitor> m_monitor;
     std::vector<InjectionRule> m_rules;
+    WatchMatcher m_matcher;
     mutable std::mutex m_mutex;
     
     Statistics m_stats;
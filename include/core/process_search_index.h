@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace xordll {
+
+
+class ProcessSearchIndex {
+public:
+    ProcessSearchIndex() = default;
+
+
+    template <typename Range, typename Projection>
+    void Build(const Range& items, Projection name) {
+        Clear();
+        for (const auto& item : items) {
+            AppendName(name(item));
+        }
+        BuildTrigrams();
+    }
+
+    void Build(const std::vector<std::wstring>& names);
+    void Clear();
+
+
+    void Find(std::wstring_view query, std::vector<uint32_t>& matches) const;
+    std::vector<uint32_t> Find(std::wstring_view query) const;
+
+    size_t Size() const { return m_offsets.empty() ? 0 : m_offsets.size() - 1; }
+    std::wstring_view Name(uint32_t index) const;
+
+private:
+    static uint64_t PackTrigram(wchar_t a, wchar_t b, wchar_t c);
+    static wchar_t Fold(wchar_t c);
+
+    void AppendName(const std::wstring& name);
+    void BuildTrigrams();
+    bool Contains(uint32_t index, std::wstring_view needle) const;
+
+    std::vector<wchar_t> m_arena;
+    std::vector<uint32_t> m_offsets;
+
+
+    std::vector<uint64_t> m_trigrams;
+    std::vector<uint32_t> m_postingOffsets;
+    std::vector<uint32_t> m_postings;
+};
+
+}
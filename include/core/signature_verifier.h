@@ -0,0 +1,66 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace xordll {
+
+
+enum class SignatureStatus {
+    Unsigned,
+    Signed,
+    Unknown
+};
+
+
+class SignatureVerifier {
+public:
+    using VerifyFunction = std::function<bool(const std::wstring& path)>;
+    using Callback = std::function<void(const std::wstring& path, SignatureStatus status)>;
+
+    explicit SignatureVerifier(VerifyFunction verify, size_t workerCount = 0);
+    ~SignatureVerifier();
+
+    SignatureVerifier(const SignatureVerifier&) = delete;
+    SignatureVerifier& operator=(const SignatureVerifier&) = delete;
+
+
+    std::shared_future<bool> Submit(const std::wstring& path, Callback callback = nullptr);
+
+
+    void Shutdown();
+
+    void SetWorkerCount(size_t workerCount);
+    size_t PendingCount() const;
+
+private:
+    struct Job {
+        std::wstring path;
+        std::promise<bool> promise;
+        std::shared_future<bool> future;
+        std::vector<Callback> callbacks;
+    };
+
+    void WorkerLoop();
+    static size_t DefaultWorkerCount();
+
+    VerifyFunction m_verify;
+    size_t m_workerCount;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<std::shared_ptr<Job>> m_queue;
+    std::unordered_map<std::wstring, std::shared_ptr<Job>> m_pending;
+    std::vector<std::thread> m_workers;
+    bool m_stopping;
+};
+
+}
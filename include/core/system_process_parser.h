@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace xordll {
+
+
+struct ProcessRecord {
+    uint32_t pid = 0;
+    uint32_t parentPid = 0;
+    uint64_t creationTime = 0;
+    std::wstring imageName;
+    uint32_t firstThread = 0;
+    uint32_t threadCount = 0;
+};
+
+
+struct ProcessEnumeration {
+    std::vector<ProcessRecord> processes;
+    std::vector<uint32_t> threadIds;
+
+    void Clear() {
+        processes.clear();
+        threadIds.clear();
+    }
+};
+
+
+enum class PointerWidth {
+    Bits32,
+    Bits64
+};
+
+
+bool ParseSystemProcessInformation(
+    const uint8_t* data,
+    size_t size,
+    uint64_t baseAddress,
+    PointerWidth width,
+    bool includeThreads,
+    ProcessEnumeration& out
+);
+
+}
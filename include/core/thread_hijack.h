@@ -4,6 +4,7 @@
 #include <windows.h>
 #include <string>
 #include <functional>
+#include <type_traits>
 
 namespace xordll {
 
@@ -43,6 +44,16 @@ private:
      
     void Log(LogLevel level, const std::wstring& message);
     
+     
+    template <typename Builder, typename = std::enable_if_t<std::is_invocable_r_v<std::wstring, Builder&>>>
+    void Log(LogLevel level, Builder&& build) {
+        if (IsLogEnabled(level)) {
+            Log(level, build());
+        }
+    }
+    
+    bool IsLogEnabled(LogLevel level) const;
+    
     LogCallback m_logCallback;
 };
 
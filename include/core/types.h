@@ -5,6 +5,7 @@
 #endif
 
 #include <windows.h>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
@@ -30,12 +31,12 @@ struct ProcessInfo {
     std::wstring name;
     std::wstring path;
     bool is64Bit;
-    HICON icon;
+    uint64_t creationTime;
     
-    ProcessInfo() : pid(0), is64Bit(false), icon(nullptr) {}
+    ProcessInfo() : pid(0), is64Bit(false), creationTime(0) {}
     
     ProcessInfo(ProcessId id, const std::wstring& n, const std::wstring& p, bool x64)
-        : pid(id), name(n), path(p), is64Bit(x64), icon(nullptr) {}
+        : pid(id), name(n), path(p), is64Bit(x64), creationTime(0) {}
 };
 
  
@@ -46,9 +47,10 @@ struct DllInfo {
     std::wstring version;
     bool is64Bit;
     bool isSigned;
+    bool signatureVerified;
     size_t fileSize;
     
-    DllInfo() : is64Bit(false), isSigned(false), fileSize(0) {}
+    DllInfo() : is64Bit(false), isSigned(false), signatureVerified(false), fileSize(0) {}
 };
 
  
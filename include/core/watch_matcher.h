@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace xordll {
+
+
+class WatchMatcher {
+public:
+    static constexpr uint32_t NoMatch = UINT32_MAX;
+
+    WatchMatcher() = default;
+
+
+    void Build(const std::vector<std::wstring>& patterns);
+    void Clear();
+
+
+    uint32_t FirstMatch(std::wstring_view name) const;
+    bool Matches(std::wstring_view name) const { return FirstMatch(name) != NoMatch; }
+
+
+    template <typename Visitor>
+    void ForEachMatch(std::wstring_view name, Visitor visit) const {
+        uint32_t exact = FindExact(name);
+        size_t glob = 0;
+
+        for (;;) {
+            while (glob < m_globs.size() && !MatchGlob(m_globs[glob], name)) {
+                glob++;
+            }
+
+            uint32_t globRule = glob < m_globs.size() ? m_globs[glob].rule : NoMatch;
+            if (exact == NoMatch && globRule == NoMatch) {
+                return;
+            }
+
+            if (exact < globRule) {
+                visit(exact);
+                exact = m_nextExact[exact];
+            } else {
+                visit(globRule);
+                glob++;
+            }
+        }
+    }
+
+    size_t Size() const { return m_nextExact.size(); }
+    bool Empty() const { return m_nextExact.empty(); }
+
+    static bool IsGlob(std::wstring_view pattern);
+
+private:
+    struct Bucket {
+        uint64_t hash;
+        uint32_t offset;
+        uint32_t length;
+        uint32_t firstRule;
+    };
+
+    struct Glob {
+        uint32_t rule;
+        uint32_t offset;
+        uint32_t length;
+        uint32_t minLength;
+    };
+
+    static wchar_t Fold(wchar_t c);
+    static uint64_t Hash(std::wstring_view name);
+
+    uint32_t FindExact(std::wstring_view name) const;
+    bool MatchGlob(const Glob& glob, std::wstring_view name) const;
+    bool EqualsFolded(const Bucket& bucket, std::wstring_view name) const;
+
+    std::vector<wchar_t> m_arena;
+    std::vector<Bucket> m_buckets;
+    std::vector<uint32_t> m_nextExact;
+    std::vector<Glob> m_globs;
+};
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace xordll {
+namespace ui {
+
+
+class IconCache {
+public:
+    static constexpr int NoIcon = -1;
+
+    using LoadFunction = std::function<bool(const std::wstring& path, int slot)>;
+
+    explicit IconCache(LoadFunction load, int firstSlot = 0);
+
+
+    void Update(const std::vector<std::wstring>& paths);
+
+
+    int Acquire(const std::wstring& path);
+    void Release(const std::wstring& path);
+
+
+    int IndexOf(const std::wstring& path) const;
+
+    void Clear();
+
+    size_t Size() const { return m_entries.size(); }
+    int SlotCount() const { return m_nextSlot - m_firstSlot; }
+
+private:
+    struct Entry {
+        int slot;
+        size_t refCount;
+    };
+
+    static std::wstring MakeKey(const std::wstring& path);
+    int AllocateSlot();
+
+    LoadFunction m_load;
+    int m_firstSlot;
+    int m_nextSlot;
+    std::vector<int> m_freeSlots;
+    std::unordered_map<std::wstring, Entry> m_entries;
+    std::vector<std::wstring> m_live;
+};
+
+}
+}
@@ -4,9 +4,12 @@
 #include "core/process_manager.h"
 #include "core/injection_core.h"
 #include "ui/hotkeys.h"
+#include "ui/icon_cache.h"
+#include "ui/refresh_worker.h"
 #include "ui/tray_icon.h"
 #include <commctrl.h>
 #include <dwmapi.h>
+#include <mutex>
 
 namespace xordll {
 
@@ -19,6 +22,10 @@ namespace ui {
 constexpr wchar_t WINDOW_CLASS_NAME[] = L"xorDLLMainWindow";
 
  
+constexpr UINT WM_PROCESSES_REFRESHED = WM_APP + 1;
+constexpr UINT WM_LOG_STATUS = WM_APP + 2;
+
+ 
 enum ControlId {
     ID_PROCESS_LIST = 1001,
     ID_PROCESS_SEARCH = 1002,
@@ -108,6 +115,8 @@ private:
     void OnHotkey(WPARAM wParam);
     void OnTrayIcon(LPARAM lParam);
     void OnMinimize();
+    void OnProcessesRefreshed();
+    void OnLogStatus();
     
      
     void RefreshProcessList();
@@ -127,8 +136,9 @@ private:
     
      
     void PopulateProcessList();
+    void OnGetProcessDispInfo(NMLVDISPINFOW* dispInfo);
     void FilterProcessList(const std::wstring& filter);
-    ProcessInfo* GetSelectedProcess();
+    const ProcessInfo* GetSelectedProcess();
     InjectionMethod GetSelectedMethod();
     std::wstring GetDllPath();
     void EnableControls(bool enable);
@@ -161,7 +171,8 @@ private:
     HINSTANCE m_hInstance;
     ColorScheme m_colorScheme;
     AppSettings m_settings;
-    std::vector<ProcessInfo> m_filteredProcesses;
+    ProcessSnapshotPtr m_snapshot;
+    std::vector<uint32_t> m_filteredIndices;
     ModuleHandle m_lastInjectedModule;
     ProcessId m_lastInjectedPid;
     ProcessId m_selectedPid;   
@@ -180,6 +191,13 @@ private:
     std::unique_ptr<ui::TrayIcon> m_trayIcon;
     std::unique_ptr<ui::TooltipManager> m_tooltipManager;
     std::unique_ptr<ui::AcceleratorManager> m_acceleratorManager;
+    std::unique_ptr<ui::IconCache> m_iconCache;
+    std::unique_ptr<ui::RefreshWorker> m_refreshWorker;
+    
+     
+    std::mutex m_logStatusMutex;
+    std::wstring m_logStatus;
+    bool m_logStatusPosted;
     
      
     bool m_alwaysOnTop;
@@ -191,6 +209,7 @@ private:
     static constexpr int MARGIN = 10;
     static constexpr int CONTROL_HEIGHT = 22;
     static constexpr int BUTTON_WIDTH = 75;
+    static constexpr int DEFAULT_ICON_INDEX = 0;
 };
 
  
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace xordll {
+namespace ui {
+
+
+class RefreshWorker {
+public:
+    using RefreshFunction = std::function<bool()>;
+    using CompletionFunction = std::function<void(bool success)>;
+
+    RefreshWorker(RefreshFunction refresh, CompletionFunction onComplete);
+    ~RefreshWorker();
+
+    RefreshWorker(const RefreshWorker&) = delete;
+    RefreshWorker& operator=(const RefreshWorker&) = delete;
+
+
+    bool Request();
+
+
+    void Stop();
+
+    bool IsBusy() const;
+    uint64_t CompletedCount() const;
+
+private:
+    void WorkerLoop();
+
+    RefreshFunction m_refresh;
+    CompletionFunction m_onComplete;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_requested;
+    bool m_running;
+    bool m_stopping;
+    uint64_t m_completed;
+    std::thread m_thread;
+};
+
+}
+}
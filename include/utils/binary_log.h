@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace xordll {
+namespace utils {
+
+
+struct BinaryLogRecord {
+    uint64_t timestampNs;
+    uint32_t threadId;
+    uint8_t level;
+    std::string_view tag;
+    std::string_view payload;
+};
+
+
+class BinaryLog {
+public:
+    static constexpr char Magic[4] = { 'X', 'L', 'O', 'G' };
+    static constexpr uint16_t Version = 2;
+    static constexpr size_t FileHeaderSize = 8;
+    static constexpr size_t MaxTagLength = 24;
+    static constexpr uint32_t MaxRecordSize = 1 << 20;
+    static constexpr size_t MaxDictionarySize = 256;
+    static constexpr size_t MaxSharedPrefix = 1024;
+    static constexpr size_t RecentPayloads = 16;
+
+    enum class Status {
+        Ok,
+        Incomplete,
+        Corrupt
+    };
+
+
+    static void AppendFileHeader(std::string& out);
+    static bool HasFileHeader(const char* data, size_t size);
+
+    class Encoder {
+    public:
+        void Reset();
+
+        void Append(
+            std::string& out,
+            uint64_t timestampNs,
+            uint32_t threadId,
+            uint8_t level,
+            std::wstring_view message
+        );
+
+    private:
+        std::vector<uint32_t> m_threads;
+        std::vector<std::string> m_tags;
+        std::string m_recent[RecentPayloads];
+        size_t m_recentNext = 0;
+        uint64_t m_lastTimestamp = 0;
+        bool m_resetPending = true;
+        std::string m_tag;
+        std::string m_payload;
+        std::string m_body;
+    };
+
+    class Decoder {
+    public:
+        void Reset();
+
+        Status Decode(const char* data, size_t size, BinaryLogRecord& record, size_t& consumed);
+
+    private:
+        std::vector<uint32_t> m_threads;
+        std::vector<std::string> m_tags;
+        std::string m_recent[RecentPayloads];
+        size_t m_recentNext = 0;
+        uint64_t m_lastTimestamp = 0;
+        std::string m_payload;
+    };
+
+
+    static void SplitSourceTag(std::wstring_view message, std::wstring_view& tag, std::wstring_view& body);
+
+    static void AppendUtf8(std::string& out, std::wstring_view text);
+};
+}
+}
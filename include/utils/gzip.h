@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace xordll {
+namespace utils {
+
+
+uint32_t Crc32(const void* data, size_t length, uint32_t crc = 0);
+
+
+void GzipCompress(const void* data, size_t length, std::vector<uint8_t>& out);
+
+}
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "core/types.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace xordll {
+
+
+struct LogRecordView {
+    uint64_t sequence;
+    LogLevel level;
+    std::chrono::system_clock::time_point timestamp;
+    uint32_t threadId;
+    std::wstring_view message;
+};
+
+
+class LogHistory {
+public:
+    static constexpr size_t DefaultCapacity = 1000;
+    static constexpr size_t AverageMessageLength = 160;
+
+    explicit LogHistory(size_t capacity = DefaultCapacity);
+
+
+    void Reset(size_t capacity);
+    void Clear();
+
+
+    uint64_t Append(
+        LogLevel level,
+        std::chrono::system_clock::time_point timestamp,
+        uint32_t threadId,
+        std::wstring_view message
+    );
+
+
+    template <typename Visitor>
+    uint64_t Read(uint64_t afterSequence, size_t maxCount, Visitor visit) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return ReadLocked(afterSequence, maxCount, visit);
+    }
+
+
+    template <typename Visitor>
+    uint64_t ReadRecent(size_t count, Visitor visit) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        uint64_t after = (m_next - m_first > count) ? m_next - count - 1 : m_first - 1;
+        return ReadLocked(after, count, visit);
+    }
+
+    uint64_t LastSequence() const;
+    size_t Size() const;
+    size_t Capacity() const { return m_slots.size(); }
+
+private:
+    struct Slot {
+        LogLevel level;
+        std::chrono::system_clock::time_point timestamp;
+        uint64_t start;
+        uint32_t length;
+        uint32_t threadId;
+    };
+
+    LogRecordView ViewOf(uint64_t sequence) const;
+
+    template <typename Visitor>
+    uint64_t ReadLocked(uint64_t afterSequence, size_t maxCount, Visitor& visit) const {
+        uint64_t sequence = std::max(afterSequence + 1, m_first);
+        uint64_t last = afterSequence;
+        for (size_t count = 0; sequence < m_next && count < maxCount; sequence++, count++) {
+            visit(ViewOf(sequence));
+            last = sequence;
+        }
+        return last;
+    }
+
+    std::vector<Slot> m_slots;
+    std::vector<wchar_t> m_arena;
+    uint64_t m_arenaHead;
+    uint64_t m_first;
+    uint64_t m_next;
+    mutable std::mutex m_mutex;
+};
+
+}
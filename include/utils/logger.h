@@ -1,23 +1,66 @@
 #pragma once
 
 #include "core/types.h"
+#include "utils/binary_log.h"
+#include "utils/log_history.h"
+#include "utils/mpsc_ring.h"
 #include <fstream>
 #include <mutex>
 #include <queue>
 #include <chrono>
+#include <ctime>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <type_traits>
+
+ 
+#ifndef XORDLL_LOG_MIN_LEVEL
+#define XORDLL_LOG_MIN_LEVEL 0
+#endif
 
 namespace xordll {
 
  
+constexpr bool IsLogLevelCompiled(LogLevel level) {
+    return static_cast<int>(level) >= XORDLL_LOG_MIN_LEVEL;
+}
+
+ 
 struct LogEntry {
     LogLevel level;
     std::wstring message;
     std::chrono::system_clock::time_point timestamp;
+    DWORD threadId;
+    
+    LogEntry() : level(LogLevel::Info), threadId(0) {}
     
     LogEntry(LogLevel lvl, const std::wstring& msg)
         : level(lvl)
         , message(msg)
-        , timestamp(std::chrono::system_clock::now()) {}
+        , timestamp(std::chrono::system_clock::now())
+        , threadId(GetCurrentThreadId()) {}
+};
+
+ 
+enum class LogFileFormat {
+    Text,
+    Binary
+};
+
+ 
+enum class LogOverflowPolicy {
+    Drop,
+    Block
+};
+
+ 
+struct LogRotationPolicy {
+    size_t maxFileSize = 5 * 1024 * 1024;
+    std::chrono::seconds maxFileAge = std::chrono::hours(24);
+    size_t maxArchives = 10;
+    std::chrono::seconds maxArchiveAge = std::chrono::hours(24 * 30);
+    bool compressArchives = true;
 };
 
  
@@ -35,22 +78,51 @@ public:
      
     bool Initialize(
         const std::wstring& logFilePath = L"",
-        size_t maxFileSize = 5 * 1024 * 1024   
+        size_t maxFileSize = 5 * 1024 * 1024,
+        LogFileFormat format = LogFileFormat::Text
     );
     
      
+    LogFileFormat GetFileFormat() const { return m_fileFormat; }
+    
+     
     void Shutdown();
     
      
     void SetMinLevel(LogLevel level);
     
      
+    bool IsEnabled(LogLevel level) const {
+        return IsLogLevelCompiled(level) && level >= m_minLevel.load(std::memory_order_relaxed);
+    }
+    
+     
     void SetUICallback(LogCallback callback);
     
      
+    void SetOverflowPolicy(LogOverflowPolicy policy) { m_overflowPolicy = policy; }
+    
+     
+    void SetRotationPolicy(const LogRotationPolicy& policy);
+    
+     
+    void Flush();
+    
+     
+    uint64_t GetDroppedCount() const { return m_droppedTotal; }
+    
+     
     void Log(LogLevel level, const std::wstring& message);
     
      
+    template <typename Builder, typename = std::enable_if_t<std::is_invocable_r_v<std::wstring, Builder&>>>
+    void Log(LogLevel level, Builder&& build) {
+        if (IsEnabled(level)) {
+            Log(level, build());
+        }
+    }
+    
+     
     void Debug(const std::wstring& message);
     
      
@@ -69,6 +141,18 @@ public:
     std::vector<LogEntry> GetRecentEntries(size_t count = 100) const;
     
      
+    template <typename Visitor>
+    uint64_t ReadEntries(uint64_t afterSequence, Visitor visit, size_t maxCount = SIZE_MAX) const {
+        return m_history.Read(afterSequence, maxCount, visit);
+    }
+    
+     
+    uint64_t GetLastSequence() const { return m_history.LastSequence(); }
+    
+     
+    void SetHistoryCapacity(size_t entries);
+    
+     
     void ClearEntries();
     
      
@@ -84,30 +168,98 @@ private:
     Logger();
     ~Logger();
     
-    void WriteToFile(const LogEntry& entry);
+     
+    struct FormatState {
+        std::time_t second = -1;
+        char text[32] = {};
+        size_t length = 0;
+        utils::BinaryLog::Encoder binary;
+    };
+    
+    static void AppendEntry(
+        std::string& out,
+        LogFileFormat format,
+        FormatState& state,
+        LogLevel level,
+        std::chrono::system_clock::time_point timestamp,
+        DWORD threadId,
+        std::wstring_view message
+    );
+    
+    void Enqueue(LogEntry&& entry);
+    void WakeWriter();
+    void WriterThread();
+    bool OpenLogFile(bool truncate);
+    bool RotationDue(size_t incoming) const;
+    void WriteEntries(const std::vector<LogEntry>& entries);
+    void WriteToFile(const std::string& data);
     void RotateLogFile();
-    std::wstring FormatEntry(const LogEntry& entry) const;
+    bool ArchiveLogFile(std::chrono::system_clock::time_point now);
+    void RequestArchiveSweep();
+    void ArchiveThread();
     std::wstring GetDefaultLogPath() const;
     
-    std::wofstream m_logFile;
+    std::ofstream m_logFile;
     std::wstring m_logFilePath;
-    size_t m_maxFileSize;
+    LogRotationPolicy m_rotation;
     size_t m_currentFileSize;
+    std::chrono::system_clock::time_point m_segmentStart;
+    std::chrono::system_clock::time_point m_rotationRetryAt;
+    LogFileFormat m_fileFormat;
+    FormatState m_formatState;
+    std::string m_batch;
     
-    LogLevel m_minLevel;
-    LogCallback m_uiCallback;
+    std::atomic<LogLevel> m_minLevel;
+    std::shared_ptr<const LogCallback> m_uiCallback;
     
-    std::vector<LogEntry> m_entries;
-    mutable std::mutex m_mutex;
+    LogHistory m_history;
     
-    bool m_initialized;
+     
+    utils::MpscRing<LogEntry> m_queue;
+    std::atomic<LogOverflowPolicy> m_overflowPolicy;
+    std::atomic<uint64_t> m_dropped;
+    std::atomic<uint64_t> m_droppedTotal;
+    
+    std::thread m_writer;
+    std::mutex m_fileMutex;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+    std::condition_variable m_flushCondition;
+    std::atomic<bool> m_writerIdle;
+    std::atomic<bool> m_stopping;
+    bool m_flushRequested;
+    size_t m_flushedPosition;
+    
+     
+    std::thread m_archiver;
+    std::mutex m_archiveMutex;
+    std::condition_variable m_archiveCondition;
+    bool m_archiveRequested;
+    bool m_archiveStopping;
+    
+    std::atomic<bool> m_initialized;
 };
 
  
-#define LOG_DEBUG(msg) xordll::Logger::Instance().Debug(msg)
-#define LOG_INFO(msg) xordll::Logger::Instance().Info(msg)
-#define LOG_WARNING(msg) xordll::Logger::Instance().Warning(msg)
-#define LOG_ERROR(msg) xordll::Logger::Instance().Error(msg)
-#define LOG_WIN_ERROR(op) xordll::Logger::Instance().LogWindowsError(op)
+#define XORDLL_LOG_AT(level, ...) \
+    do { \
+        if constexpr (xordll::IsLogLevelCompiled(level)) { \
+            xordll::Logger& xordllLogger = xordll::Logger::Instance(); \
+            if (xordllLogger.IsEnabled(level)) { \
+                xordllLogger.Log(level, __VA_ARGS__); \
+            } \
+        } \
+    } while (0)
+
+#define LOG_DEBUG(...) XORDLL_LOG_AT(xordll::LogLevel::Debug, __VA_ARGS__)
+#define LOG_INFO(...) XORDLL_LOG_AT(xordll::LogLevel::Info, __VA_ARGS__)
+#define LOG_WARNING(...) XORDLL_LOG_AT(xordll::LogLevel::Warning, __VA_ARGS__)
+#define LOG_ERROR(...) XORDLL_LOG_AT(xordll::LogLevel::Error, __VA_ARGS__)
+#define LOG_WIN_ERROR(op) \
+    do { \
+        if constexpr (xordll::IsLogLevelCompiled(xordll::LogLevel::Error)) { \
+            xordll::Logger::Instance().LogWindowsError(op); \
+        } \
+    } while (0)
 
 }  
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace xordll {
+namespace utils {
+
+
+class MappedFile {
+public:
+#ifdef _WIN32
+    using PathType = std::wstring;
+#else
+    using PathType = std::string;
+#endif
+
+    MappedFile();
+    explicit MappedFile(const PathType& path);
+    ~MappedFile();
+
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+
+    bool Open(const PathType& path);
+
+
+    void Close();
+
+    bool IsOpen() const { return m_open; }
+    const uint8_t* Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+
+private:
+    void MoveFrom(MappedFile& other);
+
+    const uint8_t* m_data;
+    size_t m_size;
+    bool m_open;
+
+#ifdef _WIN32
+    void* m_file;
+    void* m_mapping;
+#endif
+};
+
+}
+}
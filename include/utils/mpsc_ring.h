@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace xordll {
+namespace utils {
+
+
+template <typename T>
+class MpscRing {
+public:
+    explicit MpscRing(size_t capacity)
+        : m_head(0)
+        , m_tail(0)
+    {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+
+        m_cells.reset(new Cell[size]);
+        m_mask = size - 1;
+        for (size_t i = 0; i < size; i++) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+
+    bool TryPush(T&& value) {
+        size_t pos = m_head.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = m_cells[pos & m_mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+            if (diff == 0) {
+                if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+
+    bool TryPop(T& value) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        Cell& cell = m_cells[tail & m_mask];
+        if (cell.sequence.load(std::memory_order_acquire) != tail + 1) {
+            return false;
+        }
+
+        value = std::move(cell.value);
+        cell.sequence.store(tail + m_mask + 1, std::memory_order_release);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Empty() const {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        return m_cells[tail & m_mask].sequence.load(std::memory_order_acquire) != tail + 1;
+    }
+
+
+    size_t Reserved() const { return m_head.load(std::memory_order_acquire); }
+    size_t Consumed() const { return m_tail.load(std::memory_order_acquire); }
+
+    size_t Capacity() const { return m_mask + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask;
+
+    alignas(64) std::atomic<size_t> m_head;
+    alignas(64) std::atomic<size_t> m_tail;
+};
+
+}
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace xordll {
+namespace utils {
+
+
+uint64_t XXHash64(const void* data, size_t length, uint64_t seed = 0);
+
+}
+}
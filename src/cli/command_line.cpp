@@ -6,16 +6,210 @@
 #include "core/dll_loader.h"
 #include "core/injection_profile.h"
 #include "core/process_monitor.h"
+#include "utils/binary_log.h"
+#include "utils/file_utils.h"
+#include "utils/logger.h"
 #include "utils/string_utils.h"
+#include "utils/work_stealing_pool.h"
 #include "version.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <ctime>
+#include <deque>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <mutex>
 
 namespace xordll {
 namespace cli {
 
 bool Console::s_colorsEnabled = true;
 
+namespace {
+
+void CollectDlls(const std::wstring& directory, bool recursive, std::vector<std::wstring>& files) {
+    WIN32_FIND_DATAW findData;
+    HANDLE hFind = FindFirstFileW((directory + L"\\*").c_str(), &findData);
+    if (hFind == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    
+    do {
+        std::wstring name = findData.cFileName;
+        if (name == L"." || name == L"..") {
+            continue;
+        }
+        
+        std::wstring fullPath = directory + L"\\" + name;
+        if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+            if (recursive && !(findData.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)) {
+                CollectDlls(fullPath, recursive, files);
+            }
+        } else if (utils::ToLower(utils::GetExtension(name)) == L".dll") {
+            files.push_back(fullPath);
+        }
+    } while (FindNextFileW(hFind, &findData));
+    
+    FindClose(hFind);
+}
+
+std::string JsonEscape(const std::wstring& value) {
+    std::string utf8 = utils::WideToUtf8(value);
+    std::string result;
+    result.reserve(utf8.size() + 2);
+    
+    for (char c : utf8) {
+        switch (c) {
+            case '"': result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\n': result += "\\n"; break;
+            case '\r': result += "\\r"; break;
+            case '\t': result += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+                    result += escaped;
+                } else {
+                    result += c;
+                }
+                break;
+        }
+    }
+    
+    return result;
+}
+
+constexpr size_t LogReadChunkSize = 64 * 1024;
+constexpr DWORD LogFollowInterval = 250;
+
+enum class LogReadStatus {
+    Ok,
+    OpenFailed,
+    BadHeader,
+    Corrupt
+};
+
+struct LogRecordFilter {
+    uint8_t minLevel = 0;
+    std::string tag;
+    std::string grep;
+    bool hasThread = false;
+    uint32_t threadId = 0;
+    
+    bool Matches(const utils::BinaryLogRecord& record) const {
+        if (record.level < minLevel) return false;
+        if (hasThread && record.threadId != threadId) return false;
+        if (!tag.empty() && record.tag != tag) return false;
+        if (!grep.empty() && record.payload.find(grep) == std::string_view::npos) return false;
+        return true;
+    }
+};
+
+struct StoredLogRecord {
+    uint64_t timestampNs;
+    uint32_t threadId;
+    uint8_t level;
+    std::string tag;
+    std::string payload;
+};
+
+bool ParseLogLevel(const std::wstring& text, LogLevel& level) {
+    std::wstring name = utils::ToLower(text);
+    if (name == L"debug") level = LogLevel::Debug;
+    else if (name == L"info") level = LogLevel::Info;
+    else if (name == L"warning" || name == L"warn") level = LogLevel::Warning;
+    else if (name == L"error") level = LogLevel::Error;
+    else return false;
+    return true;
+}
+
+ 
+template <typename Visitor>
+LogReadStatus ReadLogRecords(
+    const std::wstring& path,
+    uint64_t& offset,
+    std::string& pending,
+    utils::BinaryLog::Decoder& decoder,
+    Visitor&& visitor
+) {
+    std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        return LogReadStatus::OpenFailed;
+    }
+    
+    if (offset == 0) {
+        char header[utils::BinaryLog::FileHeaderSize];
+        if (!file.read(header, sizeof(header)) || !utils::BinaryLog::HasFileHeader(header, sizeof(header))) {
+            return LogReadStatus::BadHeader;
+        }
+        offset = sizeof(header);
+        decoder.Reset();
+    }
+    
+    file.seekg(static_cast<std::streamoff>(offset));
+    std::vector<char> chunk(LogReadChunkSize);
+    
+    while (file.read(chunk.data(), static_cast<std::streamsize>(chunk.size())) || file.gcount() > 0) {
+        size_t received = static_cast<size_t>(file.gcount());
+        offset += received;
+        pending.append(chunk.data(), received);
+        
+        size_t position = 0;
+        for (;;) {
+            utils::BinaryLogRecord record;
+            size_t consumed = 0;
+            auto status = decoder.Decode(pending.data() + position, pending.size() - position, record, consumed);
+            if (status == utils::BinaryLog::Status::Incomplete) {
+                break;
+            }
+            if (status == utils::BinaryLog::Status::Corrupt) {
+                pending.erase(0, position);
+                return LogReadStatus::Corrupt;
+            }
+            
+            visitor(record);
+            position += consumed;
+        }
+        pending.erase(0, position);
+    }
+    
+    return LogReadStatus::Ok;
+}
+
+void PrintLogRecord(const utils::BinaryLogRecord& record) {
+    std::time_t second = static_cast<std::time_t>(record.timestampNs / 1000000000ULL);
+    std::tm tm;
+    localtime_s(&tm, &second);
+    
+    wchar_t stamp[48];
+    size_t length = std::wcsftime(stamp, 32, L"%Y-%m-%d %H:%M:%S", &tm);
+    swprintf_s(stamp + length, 48 - length, L".%09llu ", record.timestampNs % 1000000000ULL);
+    
+    LogLevel level = static_cast<LogLevel>(record.level);
+    Console::Color color = Console::Color::Default;
+    switch (level) {
+        case LogLevel::Info:    color = Console::Color::Cyan; break;
+        case LogLevel::Warning: color = Console::Color::Yellow; break;
+        case LogLevel::Error:   color = Console::Color::Red; break;
+        default: break;
+    }
+    
+    std::wstring line = L"[tid " + std::to_wstring(record.threadId) + L"] ";
+    if (!record.tag.empty()) {
+        line += L"[" + utils::Utf8ToWide(std::string(record.tag)) + L"] ";
+    }
+    line += utils::Utf8ToWide(std::string(record.payload));
+    
+    Console::Print(stamp);
+    Console::Print(L"[" + Logger::LevelToString(level) + L"] ", color);
+    Console::PrintLine(line);
+}
+
+}
+
  
  
  
@@ -32,7 +226,8 @@ void CommandLine::RegisterCommands() {
         { L"help", L"h", L"Show help message", false, false, L"" },
         { L"version", L"v", L"Show version information", false, false, L"" },
         { L"quiet", L"q", L"Suppress output", false, false, L"" },
-        { L"no-color", L"", L"Disable colored output", false, false, L"" }
+        { L"no-color", L"", L"Disable colored output", false, false, L"" },
+        { L"binary-log", L"", L"Write the CLI log in the binary .xlog format", false, false, L"" }
     };
     
      
@@ -80,7 +275,12 @@ void CommandLine::RegisterCommands() {
         L"Show information about a process or DLL",
         {
             { L"pid", L"p", L"Process ID", false, true, L"" },
-            { L"dll", L"d", L"DLL path", false, true, L"" }
+            { L"dll", L"d", L"DLL path", false, true, L"" },
+            { L"exports", L"e", L"List exported functions of --dll", false, false, L"" },
+            { L"dir", L"", L"Inspect every DLL in a directory", false, true, L"" },
+            { L"recursive", L"r", L"Include subdirectories of --dir", false, false, L"" },
+            { L"jobs", L"j", L"Worker threads for --dir", false, true, L"0" },
+            { L"json", L"", L"Print --dir results as JSON lines", false, false, L"" }
         },
         [this](const ParsedOptions& opts) { return HandleInfo(opts); }
     };
@@ -110,6 +310,22 @@ void CommandLine::RegisterCommands() {
         },
         [this](const ParsedOptions& opts) { return HandleMonitor(opts); }
     };
+    
+     
+    m_commands[L"log"] = {
+        L"log",
+        L"Decode and filter a binary log file",
+        {
+            { L"file", L"f", L"Binary log file (.xlog)", true, true, L"" },
+            { L"level", L"l", L"Minimum level (debug, info, warning, error)", false, true, L"debug" },
+            { L"tag", L"t", L"Only records with this source tag", false, true, L"" },
+            { L"thread", L"", L"Only records from this thread ID", false, true, L"" },
+            { L"grep", L"g", L"Only records whose message contains text", false, true, L"" },
+            { L"tail", L"n", L"Show only the last N matching records", false, true, L"0" },
+            { L"follow", L"", L"Keep printing records as they are appended", false, false, L"" }
+        },
+        [this](const ParsedOptions& opts) { return HandleLog(opts); }
+    };
 }
 
 ParsedOptions CommandLine::Parse(int argc, wchar_t* argv[]) {
@@ -307,8 +523,9 @@ int CommandLine::HandleInject(const ParsedOptions& options) {
         ProcessManager pm;
         pm.RefreshProcessList();
         
-        auto processes = pm.FilterByName(processName);
-        if (processes.empty()) {
+        ProcessSnapshotPtr snapshot = pm.GetSnapshot();
+        auto matches = snapshot->FilterByName(processName);
+        if (matches.empty()) {
             if (options.HasOption(L"wait")) {
                 Console::Info(L"Waiting for process: " + processName);
                  
@@ -317,8 +534,9 @@ int CommandLine::HandleInject(const ParsedOptions& options) {
                 return 1;
             }
         } else {
-            pid = processes[0].pid;
-            Console::Info(L"Found process: " + processes[0].name + L" (PID: " + std::to_wstring(pid) + L")");
+            const ProcessInfo& proc = snapshot->processes[matches[0]];
+            pid = proc.pid;
+            Console::Info(L"Found process: " + proc.name + L" (PID: " + std::to_wstring(pid) + L")");
         }
     } else {
         Console::Error(L"Either --pid or --name is required");
@@ -397,33 +615,33 @@ int CommandLine::HandleList(const ParsedOptions& options) {
     pm.RefreshProcessList();
     
     std::wstring filter = options.GetOption(L"filter");
-    auto processes = filter.empty() ? pm.GetProcessList() : pm.FilterByName(filter);
+    ProcessSnapshotPtr snapshot = pm.GetSnapshot();
+    auto matches = snapshot->FilterByName(filter);
     
      
-    if (options.HasOption(L"x64")) {
-        processes.erase(
-            std::remove_if(processes.begin(), processes.end(),
-                [](const ProcessInfo& p) { return !p.is64Bit; }),
-            processes.end()
-        );
-    } else if (options.HasOption(L"x86")) {
-        processes.erase(
-            std::remove_if(processes.begin(), processes.end(),
-                [](const ProcessInfo& p) { return p.is64Bit; }),
-            processes.end()
-        );
+    bool x64Only = options.HasOption(L"x64");
+    bool x86Only = !x64Only && options.HasOption(L"x86");
+    
+    std::vector<const ProcessInfo*> processes;
+    processes.reserve(matches.size());
+    for (uint32_t index : matches) {
+        const ProcessInfo& proc = snapshot->processes[index];
+        if ((x64Only && !proc.is64Bit) || (x86Only && proc.is64Bit)) {
+            continue;
+        }
+        processes.push_back(&proc);
     }
     
      
     std::vector<std::wstring> headers = { L"PID", L"Name", L"Arch", L"Path" };
     std::vector<std::vector<std::wstring>> rows;
     
-    for (const auto& proc : processes) {
+    for (const ProcessInfo* proc : processes) {
         std::vector<std::wstring> row;
-        row.push_back(std::to_wstring(proc.pid));
-        row.push_back(proc.name);
-        row.push_back(proc.is64Bit ? L"x64" : L"x86");
-        row.push_back(proc.path);
+        row.push_back(std::to_wstring(proc->pid));
+        row.push_back(proc->name);
+        row.push_back(proc->is64Bit ? L"x64" : L"x86");
+        row.push_back(proc->path);
         rows.push_back(row);
     }
     
@@ -435,17 +653,26 @@ int CommandLine::HandleList(const ParsedOptions& options) {
 }
 
 int CommandLine::HandleInfo(const ParsedOptions& options) {
+    if (options.HasOption(L"dir")) {
+        return HandleInfoDirectory(options);
+    }
+    
     if (options.HasOption(L"dll")) {
         std::wstring dllPath = options.GetOption(L"dll");
         
         DllLoader& loader = DllLoader::Instance();
         DllInfo info;
+        ExportIndex exports;
         
-        if (!loader.LoadDll(dllPath, info)) {
+        if (!loader.LoadDll(dllPath, info, exports)) {
             Console::Error(L"Failed to load DLL info");
             return 1;
         }
         
+        if (!info.signatureVerified) {
+            info.isSigned = loader.VerifySignatureAsync(dllPath).get();
+        }
+        
         Console::PrintLine(L"DLL Information:", Console::Color::Cyan);
         Console::PrintLine(L"  Path: " + info.path);
         Console::PrintLine(L"  Architecture: " + std::wstring(info.is64Bit ? L"x64" : L"x86"));
@@ -453,7 +680,27 @@ int CommandLine::HandleInfo(const ParsedOptions& options) {
         Console::PrintLine(L"  Description: " + info.description);
         Console::PrintLine(L"  Version: " + info.version);
         
-         
+        Console::PrintLine(L"  Exports: " + std::to_wstring(exports.Count()));
+        
+        if (options.HasOption(L"exports") && !exports.IsEmpty()) {
+            std::vector<std::wstring> headers = { L"Ordinal", L"Name", L"Target" };
+            std::vector<std::vector<std::wstring>> rows;
+            rows.reserve(exports.Count());
+            
+            for (const auto& symbol : exports.Symbols()) {
+                wchar_t rva[16];
+                swprintf_s(rva, L"0x%08X", symbol.rva);
+                
+                rows.push_back({
+                    std::to_wstring(symbol.ordinal),
+                    symbol.name.empty() ? L"-" : utils::Utf8ToWide(std::string(symbol.name)),
+                    symbol.IsForwarder() ? utils::Utf8ToWide(std::string(symbol.forwarder)) : std::wstring(rva)
+                });
+            }
+            
+            Console::PrintLine();
+            Console::PrintTable(headers, rows);
+        }
         
         return 0;
     }
@@ -464,7 +711,8 @@ int CommandLine::HandleInfo(const ParsedOptions& options) {
         ProcessManager pm;
         pm.RefreshProcessList();
         
-        auto proc = pm.FindByPid(pid);
+        ProcessSnapshotPtr snapshot = pm.GetSnapshot();
+        const ProcessInfo* proc = snapshot->FindByPid(pid);
         if (!proc) {
             Console::Error(L"Process not found");
             return 1;
@@ -479,10 +727,140 @@ int CommandLine::HandleInfo(const ParsedOptions& options) {
         return 0;
     }
     
-    Console::Error(L"Either --pid or --dll is required");
+    Console::Error(L"Either --pid, --dll or --dir is required");
     return 1;
 }
 
+int CommandLine::HandleInfoDirectory(const ParsedOptions& options) {
+    std::wstring directory = options.GetOption(L"dir");
+    while (directory.size() > 1 && (directory.back() == L'\\' || directory.back() == L'/')) {
+        directory.pop_back();
+    }
+    
+    if (!utils::DirectoryExists(directory)) {
+        Console::Error(L"Directory not found: " + directory);
+        return 1;
+    }
+    
+    std::vector<std::wstring> files;
+    CollectDlls(directory, options.HasOption(L"recursive"), files);
+    std::sort(files.begin(), files.end());
+    
+    bool json = options.HasOption(L"json");
+    if (files.empty()) {
+        if (!json) {
+            Console::Warning(L"No DLLs found in " + directory);
+        }
+        return 0;
+    }
+    
+    int jobs = std::max(options.GetIntOption(L"jobs", 0), 0);
+    DllLoader& loader = DllLoader::Instance();
+    if (jobs > 0) {
+        loader.SetSignatureWorkers(static_cast<size_t>(jobs));
+    }
+    
+     
+    std::vector<std::wstring> headers = { L"Name", L"Arch", L"DLL", L"Exports", L"Signed", L"Version" };
+    std::vector<size_t> widths = { headers[0].length(), 4, 3, 7, 6, 0 };
+    for (const auto& file : files) {
+        widths[0] = std::max(widths[0], file.length() - directory.length() - 1);
+    }
+    
+    std::mutex outputMutex;
+    std::condition_variable doneCondition;
+    size_t completed = 0;
+    size_t failed = 0;
+    
+    auto report = [&](const std::wstring& path, const DllInfo* info, size_t exportCount) {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        
+        if (json) {
+            std::string line = "{\"path\": \"" + JsonEscape(path) + "\", \"dll\": " + (info ? "true" : "false");
+            if (info) {
+                line += ", \"arch\": \"" + std::string(info->is64Bit ? "x64" : "x86") + "\"";
+                line += ", \"exports\": " + std::to_string(exportCount);
+                const char* isSigned = !info->signatureVerified ? "null" : info->isSigned ? "true" : "false";
+                line += ", \"signed\": " + std::string(isSigned);
+                line += ", \"version\": \"" + JsonEscape(info->version) + "\"";
+                line += ", \"description\": \"" + JsonEscape(info->description) + "\"";
+            }
+            line += "}";
+            std::wcout << utils::Utf8ToWide(line) << std::endl;
+        } else {
+            std::vector<std::wstring> row = {
+                path.substr(directory.length() + 1),
+                info ? (info->is64Bit ? L"x64" : L"x86") : L"-",
+                info ? L"Yes" : L"No",
+                info ? std::to_wstring(exportCount) : L"-",
+                info ? (!info->signatureVerified ? L"?" : info->isSigned ? L"Yes" : L"No") : L"-",
+                info ? info->version : L"-"
+            };
+            for (size_t i = 0; i < row.size(); i++) {
+                Console::Print(row[i], info ? Console::Color::Default : Console::Color::Red);
+                if (i + 1 < row.size()) {
+                    std::wcout << std::wstring(std::max(widths[i], row[i].length()) - row[i].length() + 2, L' ');
+                }
+            }
+            std::wcout << std::endl;
+        }
+        
+        if (!info) {
+            failed++;
+        }
+        completed++;
+        doneCondition.notify_all();
+    };
+    
+    if (!json) {
+        for (size_t i = 0; i < headers.size(); i++) {
+            Console::Print(headers[i], Console::Color::Yellow);
+            std::wcout << std::wstring(widths[i] - std::min(widths[i], headers[i].length()) + 2, L' ');
+        }
+        std::wcout << std::endl;
+    }
+    
+     
+    {
+        utils::WorkStealingPool pool(static_cast<size_t>(jobs));
+        
+        for (const auto& file : files) {
+            pool.Submit([&loader, &report, file] {
+                auto info = std::make_shared<DllInfo>();
+                auto exports = std::make_shared<std::vector<std::string>>();
+                
+                bool loaded = loader.LoadDll(file, *info, *exports,
+                    [&report, info, exports](const std::wstring& path, SignatureStatus status) {
+                        info->isSigned = status == SignatureStatus::Signed;
+                        info->signatureVerified = status != SignatureStatus::Unknown;
+                        report(path, info.get(), exports->size());
+                    });
+                
+                if (!loaded) {
+                    report(file, nullptr, 0);
+                }
+            });
+        }
+        
+        pool.Wait();
+    }
+    
+    {
+        std::unique_lock<std::mutex> lock(outputMutex);
+        doneCondition.wait(lock, [&] { return completed == files.size(); });
+    }
+    
+    loader.FlushCache();
+    
+    if (!json) {
+        Console::PrintLine();
+        Console::Info(L"Inspected " + std::to_wstring(files.size()) + L" DLLs, " +
+            std::to_wstring(failed) + L" failed");
+    }
+    
+    return failed == 0 ? 0 : 1;
+}
+
 int CommandLine::HandleProfile(const ParsedOptions& options) {
     ProfileManager& pm = ProfileManager::Instance();
     pm.Load();
@@ -564,6 +942,111 @@ int CommandLine::HandleMonitor(const ParsedOptions& options) {
     return 0;
 }
 
+int CommandLine::HandleLog(const ParsedOptions& options) {
+    std::wstring path = options.GetOption(L"file");
+    if (path.empty() && !options.positionalArgs.empty()) {
+        path = options.positionalArgs[0];
+    }
+    
+    if (path.empty()) {
+        Console::Error(L"No log file specified");
+        return 1;
+    }
+    
+    LogRecordFilter filter;
+    LogLevel minLevel = LogLevel::Debug;
+    if (options.HasOption(L"level") && !ParseLogLevel(options.GetOption(L"level"), minLevel)) {
+        Console::Error(L"Unknown log level: " + options.GetOption(L"level"));
+        return 1;
+    }
+    filter.minLevel = static_cast<uint8_t>(minLevel);
+    filter.tag = utils::WideToUtf8(options.GetOption(L"tag"));
+    filter.grep = utils::WideToUtf8(options.GetOption(L"grep"));
+    
+    if (options.HasOption(L"thread")) {
+        filter.hasThread = true;
+        filter.threadId = static_cast<uint32_t>(wcstoul(options.GetOption(L"thread").c_str(), nullptr, 0));
+    }
+    
+    size_t tail = static_cast<size_t>(std::max(0, options.GetIntOption(L"tail", 0)));
+    bool follow = options.HasOption(L"follow");
+    
+    uint64_t offset = 0;
+    std::string pending;
+    utils::BinaryLog::Decoder decoder;
+    std::deque<StoredLogRecord> recent;
+    
+    LogReadStatus status = ReadLogRecords(path, offset, pending, decoder,
+        [&](const utils::BinaryLogRecord& record) {
+            if (!filter.Matches(record)) {
+                return;
+            }
+            if (tail == 0) {
+                PrintLogRecord(record);
+                return;
+            }
+            
+            recent.push_back(StoredLogRecord{ record.timestampNs, record.threadId, record.level,
+                std::string(record.tag), std::string(record.payload) });
+            if (recent.size() > tail) {
+                recent.pop_front();
+            }
+        });
+    
+    for (const auto& stored : recent) {
+        PrintLogRecord(utils::BinaryLogRecord{ stored.timestampNs, stored.threadId, stored.level, stored.tag,
+            stored.payload });
+    }
+    
+    if (status == LogReadStatus::OpenFailed) {
+        Console::Error(L"Failed to open log file: " + path);
+        return 1;
+    }
+    if (status == LogReadStatus::BadHeader) {
+        Console::Error(L"Not a binary xorDLL log: " + path);
+        return 1;
+    }
+    if (status == LogReadStatus::Corrupt) {
+        Console::Error(L"Corrupt record at offset " + std::to_wstring(offset - pending.size()));
+        return 1;
+    }
+    
+    if (!follow) {
+        return 0;
+    }
+    
+    auto print = [&](const utils::BinaryLogRecord& record) {
+        if (filter.Matches(record)) {
+            PrintLogRecord(record);
+        }
+    };
+    
+    while (true) {
+        Sleep(LogFollowInterval);
+        
+         
+        if (utils::GetFileSize(path) < offset) {
+            offset = 0;
+            pending.clear();
+        }
+        
+        bool fromStart = offset == 0;
+        status = ReadLogRecords(path, offset, pending, decoder, print);
+        if (status == LogReadStatus::Corrupt) {
+            if (fromStart) {
+                Console::Error(L"Corrupt record at offset " + std::to_wstring(offset - pending.size()));
+                return 1;
+            }
+            
+             
+            offset = 0;
+            pending.clear();
+        }
+    }
+    
+    return 0;
+}
+
  
  
  
@@ -50,7 +50,18 @@ int wmain(int argc, wchar_t* argv[]) {
     InitializeConsole();
     
      
-    Logger::Instance().Initialize(L"xorDLL_cli.log");
+    bool binaryLog = false;
+    for (int i = 1; i < argc; i++) {
+        if (wcscmp(argv[i], L"--binary-log") == 0) {
+            binaryLog = true;
+        }
+    }
+    
+    if (binaryLog) {
+        Logger::Instance().Initialize(L"xorDLL_cli.xlog", 5 * 1024 * 1024, LogFileFormat::Binary);
+    } else {
+        Logger::Instance().Initialize(L"xorDLL_cli.log");
+    }
     Logger::Instance().SetMinLevel(LogLevel::Warning);
     
      
@@ -0,0 +1,327 @@
+#include "core/dll_cache.h"
+#include "utils/file_utils.h"
+#include "utils/mapped_file.h"
+#include "utils/xxhash.h"
+#include <cstring>
+#include <fstream>
+
+namespace xordll {
+
+namespace {
+
+constexpr uint32_t CacheMagic = 0x434C4458;
+constexpr uint32_t CacheVersion = 1;
+
+constexpr uint8_t FlagIs64Bit = 1 << 0;
+constexpr uint8_t FlagSigned = 1 << 1;
+constexpr uint8_t FlagSignatureVerified = 1 << 2;
+
+class Writer {
+public:
+    explicit Writer(std::vector<uint8_t>& out) : m_out(out) {}
+
+    template <typename T>
+    void Write(T value) {
+        size_t pos = m_out.size();
+        m_out.resize(pos + sizeof(T));
+        std::memcpy(m_out.data() + pos, &value, sizeof(T));
+    }
+
+    void WriteString(const std::string& value) {
+        Write(static_cast<uint32_t>(value.size()));
+        m_out.insert(m_out.end(), value.begin(), value.end());
+    }
+
+    void WriteString(const std::wstring& value) {
+        Write(static_cast<uint32_t>(value.size()));
+        for (wchar_t c : value) {
+            Write(static_cast<uint16_t>(c));
+        }
+    }
+
+private:
+    std::vector<uint8_t>& m_out;
+};
+
+class Reader {
+public:
+    Reader(const uint8_t* data, size_t size) : m_data(data), m_size(size), m_pos(0) {}
+
+    template <typename T>
+    bool Read(T& value) {
+        if (m_size - m_pos < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, m_data + m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return true;
+    }
+
+    bool ReadString(std::string& value) {
+        uint32_t length = 0;
+        if (!Read(length) || m_size - m_pos < length) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(m_data + m_pos), length);
+        m_pos += length;
+        return true;
+    }
+
+    bool ReadString(std::wstring& value) {
+        uint32_t length = 0;
+        if (!Read(length) || (m_size - m_pos) / sizeof(uint16_t) < length) {
+            return false;
+        }
+        value.resize(length);
+        for (uint32_t i = 0; i < length; i++) {
+            uint16_t c;
+            Read(c);
+            value[i] = static_cast<wchar_t>(c);
+        }
+        return true;
+    }
+
+    size_t Remaining() const { return m_size - m_pos; }
+
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_pos;
+};
+
+}
+
+DllCache::DllCache(size_t capacity)
+    : m_capacity(capacity ? capacity : 1)
+    , m_dirty(false)
+{
+}
+
+bool DllCache::Find(
+    const std::wstring& key,
+    uint64_t fileSize,
+    uint64_t lastWriteTime,
+    uint64_t contentHash,
+    DllCacheEntry& entry
+) {
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+        return false;
+    }
+
+    const DllCacheEntry& cached = it->second->second;
+    if (cached.info.fileSize != fileSize ||
+        cached.lastWriteTime != lastWriteTime ||
+        cached.contentHash != contentHash) {
+        Remove(key);
+        return false;
+    }
+
+    Touch(it->second);
+    entry = cached;
+    return true;
+}
+
+void DllCache::Store(const std::wstring& key, const DllCacheEntry& entry) {
+    auto it = m_index.find(key);
+    if (it != m_index.end()) {
+        it->second->second = entry;
+        Touch(it->second);
+    } else {
+        m_entries.emplace_front(key, entry);
+        m_index[key] = m_entries.begin();
+        EvictOverflow();
+    }
+    m_dirty = true;
+}
+
+bool DllCache::UpdateSignature(const std::wstring& key, uint64_t contentHash, bool isSigned) {
+    auto it = m_index.find(key);
+    if (it == m_index.end() || it->second->second.contentHash != contentHash) {
+        return false;
+    }
+
+    DllInfo& info = it->second->second.info;
+    info.isSigned = isSigned;
+    info.signatureVerified = true;
+    m_dirty = true;
+    return true;
+}
+
+void DllCache::Remove(const std::wstring& key) {
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+        return;
+    }
+    m_entries.erase(it->second);
+    m_index.erase(it);
+    m_dirty = true;
+}
+
+void DllCache::Clear() {
+    m_dirty = m_dirty || !m_entries.empty();
+    m_entries.clear();
+    m_index.clear();
+}
+
+void DllCache::Touch(EntryList::iterator it) {
+    if (it != m_entries.begin()) {
+        m_entries.splice(m_entries.begin(), m_entries, it);
+        m_dirty = true;
+    }
+}
+
+void DllCache::EvictOverflow() {
+    while (m_entries.size() > m_capacity) {
+        m_index.erase(m_entries.back().first);
+        m_entries.pop_back();
+    }
+}
+
+std::vector<uint8_t> DllCache::Serialize() const {
+    std::vector<uint8_t> out;
+    Writer writer(out);
+
+    writer.Write(CacheMagic);
+    writer.Write(CacheVersion);
+    writer.Write(static_cast<uint32_t>(m_entries.size()));
+
+    for (const auto& pair : m_entries) {
+        const DllCacheEntry& entry = pair.second;
+        uint8_t flags = 0;
+        if (entry.info.is64Bit) flags |= FlagIs64Bit;
+        if (entry.info.isSigned) flags |= FlagSigned;
+        if (entry.info.signatureVerified) flags |= FlagSignatureVerified;
+
+        writer.WriteString(pair.first);
+        writer.WriteString(entry.info.path);
+        writer.WriteString(entry.info.name);
+        writer.WriteString(entry.info.description);
+        writer.WriteString(entry.info.version);
+        writer.Write(flags);
+        writer.Write(static_cast<uint64_t>(entry.info.fileSize));
+        writer.Write(entry.lastWriteTime);
+        writer.Write(entry.contentHash);
+
+        writer.Write(static_cast<uint32_t>(entry.exports.size()));
+        for (const auto& name : entry.exports) {
+            writer.WriteString(name);
+        }
+    }
+
+    writer.Write(utils::XXHash64(out.data(), out.size()));
+    return out;
+}
+
+bool DllCache::Deserialize(const uint8_t* data, size_t size) {
+    m_entries.clear();
+    m_index.clear();
+    m_dirty = false;
+
+    if (!data || size < sizeof(uint64_t)) {
+        return false;
+    }
+
+    uint64_t checksum;
+    size_t payloadSize = size - sizeof(uint64_t);
+    std::memcpy(&checksum, data + payloadSize, sizeof(checksum));
+    if (utils::XXHash64(data, payloadSize) != checksum) {
+        return false;
+    }
+
+    Reader reader(data, payloadSize);
+    uint32_t magic = 0, version = 0, count = 0;
+    if (!reader.Read(magic) || magic != CacheMagic ||
+        !reader.Read(version) || version != CacheVersion ||
+        !reader.Read(count)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        std::wstring key;
+        DllCacheEntry entry;
+        uint8_t flags = 0;
+        uint64_t fileSize = 0;
+        uint32_t exportCount = 0;
+
+        if (!reader.ReadString(key) ||
+            !reader.ReadString(entry.info.path) ||
+            !reader.ReadString(entry.info.name) ||
+            !reader.ReadString(entry.info.description) ||
+            !reader.ReadString(entry.info.version) ||
+            !reader.Read(flags) ||
+            !reader.Read(fileSize) ||
+            !reader.Read(entry.lastWriteTime) ||
+            !reader.Read(entry.contentHash) ||
+            !reader.Read(exportCount) ||
+            exportCount > reader.Remaining() / sizeof(uint32_t)) {
+            m_entries.clear();
+            m_index.clear();
+            return false;
+        }
+
+        entry.info.is64Bit = (flags & FlagIs64Bit) != 0;
+        entry.info.isSigned = (flags & FlagSigned) != 0;
+        entry.info.signatureVerified = (flags & FlagSignatureVerified) != 0;
+        entry.info.fileSize = static_cast<size_t>(fileSize);
+
+        entry.exports.resize(exportCount);
+        for (auto& name : entry.exports) {
+            if (!reader.ReadString(name)) {
+                m_entries.clear();
+                m_index.clear();
+                return false;
+            }
+        }
+
+        if (m_index.count(key) == 0 && m_entries.size() < m_capacity) {
+            m_entries.emplace_back(key, std::move(entry));
+            m_index[key] = std::prev(m_entries.end());
+        }
+    }
+
+    return true;
+}
+
+bool DllCache::Load(const std::wstring& path) {
+    utils::MappedFile file;
+    if (!file.Open(path)) {
+        Clear();
+        m_dirty = false;
+        return false;
+    }
+
+    return Deserialize(file.Data(), file.Size());
+}
+
+bool DllCache::Save(const std::wstring& path) {
+    std::vector<uint8_t> data = Serialize();
+    std::wstring tempPath = path + L"." + std::to_wstring(GetCurrentProcessId()) + L".tmp";
+
+    {
+        std::ofstream file(tempPath.c_str(), std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file.good()) {
+            file.close();
+            DeleteFileW(tempPath.c_str());
+            return false;
+        }
+    }
+
+    if (!MoveFileExW(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+        DeleteFileW(tempPath.c_str());
+        return false;
+    }
+
+    m_dirty = false;
+    return true;
+}
+
+std::wstring DllCache::GetDefaultPath() {
+    return utils::GetAppDataPath(L"xorDLL") + L"\\dll_cache.bin";
+}
+
+}
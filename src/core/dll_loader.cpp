@@ -2,8 +2,10 @@
 
 #include "core/dll_loader.h"
 #include "utils/file_utils.h"
+#include "utils/mapped_file.h"
 #include "utils/string_utils.h"
 #include "utils/logger.h"
+#include "utils/xxhash.h"
 #include <softpub.h>
 #include <wintrust.h>
 #include <mscat.h>
@@ -18,68 +20,236 @@ DllLoader& DllLoader::Instance() {
     return instance;
 }
 
-bool DllLoader::LoadDll(const std::wstring& path, DllInfo& info) {
+DllLoader::DllLoader()
+    : m_diskCacheLoaded(false)
+    , m_verifier(std::make_unique<SignatureVerifier>(&DllLoader::VerifyDigitalSignature))
+{
+}
+
+DllLoader::~DllLoader() {
+    m_verifier->Shutdown();
+    FlushCache();
+}
+
+void DllLoader::EnsureDiskCacheLoaded() {
+    if (m_diskCacheLoaded) {
+        return;
+    }
+    
+    m_diskCacheLoaded = true;
+    if (m_diskCache.Load(DllCache::GetDefaultPath())) {
+        LOG_DEBUG(L"DLL metadata cache loaded: " + std::to_wstring(m_diskCache.Size()) + L" entries");
+    }
+}
+
+bool DllLoader::FlushCache() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_diskCacheLoaded || !m_diskCache.IsDirty()) {
+        return true;
+    }
+    return m_diskCache.Save(DllCache::GetDefaultPath());
+}
+
+bool DllLoader::LoadDll(const std::wstring& path, DllInfo& info, SignatureCallback onSignature) {
+    return LoadEntry(path, info, nullptr, nullptr, std::move(onSignature));
+}
+
+bool DllLoader::LoadDll(
+    const std::wstring& path,
+    DllInfo& info,
+    std::vector<std::string>& exports,
+    SignatureCallback onSignature
+) {
+    return LoadEntry(path, info, &exports, nullptr, std::move(onSignature));
+}
+
+bool DllLoader::LoadDll(
+    const std::wstring& path,
+    DllInfo& info,
+    ExportIndex& exports,
+    SignatureCallback onSignature
+) {
+    return LoadEntry(path, info, nullptr, &exports, std::move(onSignature));
+}
+
+bool DllLoader::LoadEntry(
+    const std::wstring& path,
+    DllInfo& info,
+    std::vector<std::string>* exports,
+    ExportIndex* exportIndex,
+    SignatureCallback onSignature
+) {
      
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        std::unique_lock<std::mutex> lock(m_mutex);
         auto it = m_cache.find(path);
         if (it != m_cache.end()) {
-            info = it->second;
+            info = it->second.info;
+            if (exports) {
+                *exports = it->second.exports;
+            }
+            uint64_t contentHash = it->second.contentHash;
+            lock.unlock();
+            
+            if (exportIndex) {
+                GetExportIndex(path, *exportIndex);
+            }
+            
+            if (!info.signatureVerified) {
+                ScheduleSignatureCheck(path, contentHash, onSignature);
+            } else if (onSignature) {
+                onSignature(path, info.isSigned ? SignatureStatus::Signed : SignatureStatus::Unsigned);
+            }
             return true;
         }
     }
     
      
-    if (!utils::FileExists(path)) {
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (!GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &attributes) ||
+        (attributes.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
         LOG_ERROR(L"DLL file not found: " + path);
         return false;
     }
     
      
-    if (!ValidatePEHeaders(path)) {
-        LOG_ERROR(L"Invalid PE headers: " + path);
+    utils::MappedFile file;
+    if (!file.Open(path)) {
+        LOG_ERROR(L"Failed to read DLL file: " + path);
         return false;
     }
     
      
-    info.path = path;
-    info.name = utils::GetFileName(path);
-    info.fileSize = utils::GetFileSize(path);
+    std::wstring cacheKey = utils::ToLower(path);
+    uint64_t lastWriteTime = (static_cast<uint64_t>(attributes.ftLastWriteTime.dwHighDateTime) << 32) |
+        attributes.ftLastWriteTime.dwLowDateTime;
+    uint64_t contentHash = utils::XXHash64(file.Data(), file.Size());
     
-     
-    std::vector<BYTE> data;
-    if (!utils::ReadFileToMemory(path, data)) {
-        LOG_ERROR(L"Failed to read DLL file: " + path);
-        return false;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        EnsureDiskCacheLoaded();
+        
+        DllCacheEntry entry;
+        if (m_diskCache.Find(cacheKey, file.Size(), lastWriteTime, contentHash, entry)) {
+            entry.info.path = path;
+            info = entry.info;
+            if (exports) {
+                *exports = entry.exports;
+            }
+            m_cache[path] = std::move(entry);
+            lock.unlock();
+            
+            if (exportIndex) {
+                exportIndex->Build(PeImage(file.Data(), file.Size()));
+            }
+            
+            LOG_DEBUG(L"DLL metadata cache hit: " + info.name);
+            if (!info.signatureVerified) {
+                ScheduleSignatureCheck(path, contentHash, onSignature);
+            } else if (onSignature) {
+                onSignature(path, info.isSigned ? SignatureStatus::Signed : SignatureStatus::Unsigned);
+            }
+            return true;
+        }
     }
     
-    auto dosHeader = reinterpret_cast<IMAGE_DOS_HEADER*>(data.data());
-    auto ntHeaders = reinterpret_cast<IMAGE_NT_HEADERS*>(data.data() + dosHeader->e_lfanew);
+    PeImage image(file.Data(), file.Size());
+    if (!ValidatePEHeaders(image)) {
+        LOG_ERROR(L"Invalid PE headers: " + path);
+        return false;
+    }
     
-    info.is64Bit = (ntHeaders->FileHeader.Machine == IMAGE_FILE_MACHINE_AMD64);
+     
+    info.path = path;
+    info.name = utils::GetFileName(path);
+    info.fileSize = file.Size();
+    info.is64Bit = (image.Machine() == IMAGE_FILE_MACHINE_AMD64);
     
      
     info.description = GetDescription(path);
     info.version = GetVersion(path);
     
      
-    info.isSigned = VerifyDigitalSignature(path);
+    info.isSigned = false;
+    info.signatureVerified = false;
     
      
+    DllCacheEntry entry;
+    entry.info = info;
+    entry.lastWriteTime = lastWriteTime;
+    entry.contentHash = contentHash;
+    ExportIndex index(image);
+    entry.exports = GetExports(index);
+    if (exportIndex) {
+        *exportIndex = std::move(index);
+    }
+    if (exports) {
+        *exports = entry.exports;
+    }
+    
     {
         std::lock_guard<std::mutex> lock(m_mutex);
-        m_cache[path] = info;
+        m_diskCache.Store(cacheKey, entry);
+        m_cache[path] = std::move(entry);
     }
     
     LOG_DEBUG(L"DLL loaded: " + info.name + L" (" + (info.is64Bit ? L"x64" : L"x86") + L")");
+    
+    ScheduleSignatureCheck(path, contentHash, onSignature);
     return true;
 }
 
+std::shared_future<bool> DllLoader::VerifySignatureAsync(const std::wstring& path, SignatureCallback callback) {
+    uint64_t contentHash = 0;
+    
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_cache.find(path);
+        if (it != m_cache.end()) {
+            contentHash = it->second.contentHash;
+        }
+    }
+    
+    return ScheduleSignatureCheck(path, contentHash, std::move(callback));
+}
+
+void DllLoader::SetSignatureWorkers(size_t workerCount) {
+    m_verifier->SetWorkerCount(workerCount);
+}
+
+std::shared_future<bool> DllLoader::ScheduleSignatureCheck(
+    const std::wstring& path,
+    uint64_t contentHash,
+    SignatureCallback callback
+) {
+    return m_verifier->Submit(path,
+        [this, contentHash, callback](const std::wstring& verifiedPath, SignatureStatus status) {
+            if (status != SignatureStatus::Unknown) {
+                OnSignatureVerified(verifiedPath, contentHash, status == SignatureStatus::Signed);
+            }
+            if (callback) {
+                callback(verifiedPath, status);
+            }
+        });
+}
+
+void DllLoader::OnSignatureVerified(const std::wstring& path, uint64_t contentHash, bool isSigned) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    auto it = m_cache.find(path);
+    if (it != m_cache.end() && it->second.contentHash == contentHash) {
+        it->second.info.isSigned = isSigned;
+        it->second.info.signatureVerified = true;
+    }
+    
+    m_diskCache.UpdateSignature(utils::ToLower(path), contentHash, isSigned);
+}
+
 std::optional<DllInfo> DllLoader::GetCachedInfo(const std::wstring& path) const {
     std::lock_guard<std::mutex> lock(m_mutex);
     auto it = m_cache.find(path);
     if (it != m_cache.end()) {
-        return it->second;
+        return it->second.info;
     }
     return std::nullopt;
 }
@@ -87,12 +257,16 @@ std::optional<DllInfo> DllLoader::GetCachedInfo(const std::wstring& path) const
 void DllLoader::ClearCache() {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_cache.clear();
+    m_diskCache.Clear();
+    m_diskCacheLoaded = true;
     LOG_DEBUG(L"DLL cache cleared");
 }
 
 void DllLoader::RemoveFromCache(const std::wstring& path) {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_cache.erase(path);
+    EnsureDiskCacheLoaded();
+    m_diskCache.Remove(utils::ToLower(path));
 }
 
 bool DllLoader::IsCompatible(const DllInfo& dllInfo, bool processIs64Bit) {
@@ -100,36 +274,26 @@ bool DllLoader::IsCompatible(const DllInfo& dllInfo, bool processIs64Bit) {
 }
 
 bool DllLoader::ValidatePEHeaders(const std::wstring& path) {
-    std::vector<BYTE> data;
-    if (!utils::ReadFileToMemory(path, data)) {
-        return false;
-    }
-    
-    if (data.size() < sizeof(IMAGE_DOS_HEADER)) {
-        return false;
-    }
-    
-    auto dosHeader = reinterpret_cast<IMAGE_DOS_HEADER*>(data.data());
-    if (dosHeader->e_magic != IMAGE_DOS_SIGNATURE) {
-        return false;
-    }
-    
-    if (data.size() < static_cast<size_t>(dosHeader->e_lfanew) + sizeof(IMAGE_NT_HEADERS)) {
+    utils::MappedFile file;
+    if (!file.Open(path)) {
         return false;
     }
     
-    auto ntHeaders = reinterpret_cast<IMAGE_NT_HEADERS*>(data.data() + dosHeader->e_lfanew);
-    if (ntHeaders->Signature != IMAGE_NT_SIGNATURE) {
+    return ValidatePEHeaders(PeImage(file.Data(), file.Size()));
+}
+
+bool DllLoader::ValidatePEHeaders(const PeImage& image) {
+    if (!image.IsValid()) {
         return false;
     }
     
      
-    if (!(ntHeaders->FileHeader.Characteristics & IMAGE_FILE_DLL)) {
+    if (!image.IsDll()) {
         return false;
     }
     
      
-    WORD machine = ntHeaders->FileHeader.Machine;
+    WORD machine = image.Machine();
     if (machine != IMAGE_FILE_MACHINE_I386 && machine != IMAGE_FILE_MACHINE_AMD64) {
         return false;
     }
@@ -170,96 +334,38 @@ bool DllLoader::VerifyDigitalSignature(const std::wstring& path) {
 }
 
 std::vector<std::string> DllLoader::GetExports(const std::wstring& path) {
-    std::vector<std::string> exports;
-    
-    std::vector<BYTE> data;
-    if (!utils::ReadFileToMemory(path, data)) {
-        return exports;
-    }
-    
-    auto dosHeader = reinterpret_cast<IMAGE_DOS_HEADER*>(data.data());
-    if (dosHeader->e_magic != IMAGE_DOS_SIGNATURE) {
-        return exports;
+    utils::MappedFile file;
+    if (!file.Open(path)) {
+        return std::vector<std::string>();
     }
     
-    auto ntHeaders = reinterpret_cast<IMAGE_NT_HEADERS*>(data.data() + dosHeader->e_lfanew);
-    if (ntHeaders->Signature != IMAGE_NT_SIGNATURE) {
-        return exports;
-    }
-    
-     
-    DWORD exportDirRVA = 0;
-    DWORD exportDirSize = 0;
-    
-    if (ntHeaders->FileHeader.Machine == IMAGE_FILE_MACHINE_AMD64) {
-        auto ntHeaders64 = reinterpret_cast<IMAGE_NT_HEADERS64*>(ntHeaders);
-        exportDirRVA = ntHeaders64->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT].VirtualAddress;
-        exportDirSize = ntHeaders64->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT].Size;
-    } else {
-        auto ntHeaders32 = reinterpret_cast<IMAGE_NT_HEADERS32*>(ntHeaders);
-        exportDirRVA = ntHeaders32->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT].VirtualAddress;
-        exportDirSize = ntHeaders32->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT].Size;
-    }
-    
-    if (exportDirRVA == 0 || exportDirSize == 0) {
-        return exports;   
-    }
-    
-     
-    auto sectionHeader = IMAGE_FIRST_SECTION(ntHeaders);
-    DWORD exportDirOffset = 0;
-    
-    for (int i = 0; i < ntHeaders->FileHeader.NumberOfSections; i++) {
-        if (exportDirRVA >= sectionHeader[i].VirtualAddress &&
-            exportDirRVA < sectionHeader[i].VirtualAddress + sectionHeader[i].Misc.VirtualSize) {
-            exportDirOffset = exportDirRVA - sectionHeader[i].VirtualAddress + sectionHeader[i].PointerToRawData;
-            break;
-        }
-    }
-    
-    if (exportDirOffset == 0 || exportDirOffset >= data.size()) {
-        return exports;
-    }
-    
-    auto exportDir = reinterpret_cast<IMAGE_EXPORT_DIRECTORY*>(data.data() + exportDirOffset);
-    
-     
-    DWORD namesRVA = exportDir->AddressOfNames;
-    DWORD namesOffset = 0;
-    
-    for (int i = 0; i < ntHeaders->FileHeader.NumberOfSections; i++) {
-        if (namesRVA >= sectionHeader[i].VirtualAddress &&
-            namesRVA < sectionHeader[i].VirtualAddress + sectionHeader[i].Misc.VirtualSize) {
-            namesOffset = namesRVA - sectionHeader[i].VirtualAddress + sectionHeader[i].PointerToRawData;
-            break;
+    return GetExports(PeImage(file.Data(), file.Size()));
+}
+
+std::vector<std::string> DllLoader::GetExports(const PeImage& image) {
+    return GetExports(ExportIndex(image));
+}
+
+std::vector<std::string> DllLoader::GetExports(const ExportIndex& index) {
+    std::vector<std::string> exports;
+    exports.reserve(index.Count());
+    for (const auto& symbol : index.Symbols()) {
+        if (!symbol.name.empty()) {
+            exports.emplace_back(symbol.name);
         }
     }
     
-    if (namesOffset == 0) {
-        return exports;
-    }
-    
-    auto nameRVAs = reinterpret_cast<DWORD*>(data.data() + namesOffset);
-    
-    for (DWORD i = 0; i < exportDir->NumberOfNames && i < 1000; i++) {   
-        DWORD nameRVA = nameRVAs[i];
-        DWORD nameOffset = 0;
-        
-        for (int j = 0; j < ntHeaders->FileHeader.NumberOfSections; j++) {
-            if (nameRVA >= sectionHeader[j].VirtualAddress &&
-                nameRVA < sectionHeader[j].VirtualAddress + sectionHeader[j].Misc.VirtualSize) {
-                nameOffset = nameRVA - sectionHeader[j].VirtualAddress + sectionHeader[j].PointerToRawData;
-                break;
-            }
-        }
-        
-        if (nameOffset > 0 && nameOffset < data.size()) {
-            const char* name = reinterpret_cast<const char*>(data.data() + nameOffset);
-            exports.push_back(name);
-        }
+    return exports;
+}
+
+bool DllLoader::GetExportIndex(const std::wstring& path, ExportIndex& index) {
+    utils::MappedFile file;
+    if (!file.Open(path)) {
+        index.Clear();
+        return false;
     }
     
-    return exports;
+    return index.Build(PeImage(file.Data(), file.Size()));
 }
 
 std::wstring DllLoader::GetDescription(const std::wstring& path) {
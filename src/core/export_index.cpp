@@ -0,0 +1,361 @@
+#include "core/export_index.h"
+#include <cstring>
+
+namespace xordll {
+
+namespace {
+
+constexpr size_t ExportDirectorySize = 40;
+constexpr uint32_t MaxOrdinals = 0x10000;
+constexpr uint32_t EmptySlot = 0;
+
+struct PendingSymbol {
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    uint32_t forwarderOffset;
+    uint32_t forwarderLength;
+    uint16_t ordinal;
+    uint32_t rva;
+};
+
+uint32_t ReadU32(const uint8_t* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+uint16_t ReadU16(const uint8_t* data) {
+    uint16_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+}
+
+namespace pe {
+
+bool ParseForwarder(std::string_view forwarder, ForwarderTarget& out) {
+    size_t dot = forwarder.find('.');
+    if (dot == std::string_view::npos || dot == 0 || dot + 1 >= forwarder.size()) {
+        return false;
+    }
+
+    out.module.assign(forwarder.data(), dot);
+    std::string_view function = forwarder.substr(dot + 1);
+
+    out.byOrdinal = function[0] == '#';
+    out.ordinal = 0;
+    out.name.clear();
+
+    if (!out.byOrdinal) {
+        out.name.assign(function.data(), function.size());
+        return true;
+    }
+
+    uint32_t ordinal = 0;
+    for (size_t i = 1; i < function.size(); i++) {
+        char c = function[i];
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        ordinal = ordinal * 10 + static_cast<uint32_t>(c - '0');
+        if (ordinal >= MaxOrdinals) {
+            return false;
+        }
+    }
+
+    out.ordinal = static_cast<uint16_t>(ordinal);
+    return function.size() > 1;
+}
+
+}
+
+ExportIndex::ExportIndex()
+    : m_ordinalBase(0)
+{
+}
+
+ExportIndex::ExportIndex(const PeImage& image)
+    : ExportIndex()
+{
+    Build(image);
+}
+
+ExportIndex::ExportIndex(const ExportIndex& other)
+    : m_symbols(other.m_symbols)
+    , m_nameSlots(other.m_nameSlots)
+    , m_ordinalSlots(other.m_ordinalSlots)
+    , m_strings(other.m_strings)
+    , m_ordinalBase(other.m_ordinalBase)
+{
+    RebindViews(other);
+}
+
+ExportIndex& ExportIndex::operator=(const ExportIndex& other) {
+    if (this != &other) {
+        m_symbols = other.m_symbols;
+        m_nameSlots = other.m_nameSlots;
+        m_ordinalSlots = other.m_ordinalSlots;
+        m_strings = other.m_strings;
+        m_ordinalBase = other.m_ordinalBase;
+        RebindViews(other);
+    }
+    return *this;
+}
+
+void ExportIndex::RebindViews(const ExportIndex& other) {
+    const char* oldBase = other.m_strings.data();
+    const char* newBase = m_strings.data();
+
+    auto rebind = [&](std::string_view view) {
+        return view.empty() ? view : std::string_view(newBase + (view.data() - oldBase), view.size());
+    };
+
+    for (auto& symbol : m_symbols) {
+        symbol.name = rebind(symbol.name);
+        symbol.forwarder = rebind(symbol.forwarder);
+    }
+}
+
+void ExportIndex::Clear() {
+    m_symbols.clear();
+    m_nameSlots.clear();
+    m_ordinalSlots.clear();
+    m_strings.clear();
+    m_ordinalBase = 0;
+}
+
+bool ExportIndex::Build(const PeImage& image) {
+    Clear();
+
+    pe::DataDirectory dir = image.Directory(pe::DirectoryExport);
+    if (!image.IsValid() || dir.virtualAddress == 0 || dir.size == 0) {
+        return false;
+    }
+
+    auto locate = [&image](uint32_t rva, size_t& available) {
+        return image.RvaToSpan(rva, available);
+    };
+    return BuildFrom(locate, dir.virtualAddress, dir.size);
+}
+
+bool ExportIndex::Build(const uint8_t* directory, size_t size, uint32_t directoryRva) {
+    Clear();
+
+    if (!directory || size == 0 || size > UINT32_MAX) {
+        return false;
+    }
+
+    auto locate = [=](uint32_t rva, size_t& available) -> const uint8_t* {
+        if (rva < directoryRva || rva - directoryRva >= size) {
+            return nullptr;
+        }
+        available = size - (rva - directoryRva);
+        return directory + (rva - directoryRva);
+    };
+    return BuildFrom(locate, directoryRva, static_cast<uint32_t>(size));
+}
+
+template <typename Locate>
+bool ExportIndex::BuildFrom(Locate locate, uint32_t directoryRva, uint32_t directorySize) {
+    size_t available = 0;
+    const uint8_t* directory = locate(directoryRva, available);
+    if (!directory || available < ExportDirectorySize) {
+        return false;
+    }
+
+    uint32_t base = ReadU32(directory + 16);
+    uint32_t numberOfFunctions = ReadU32(directory + 20);
+    uint32_t numberOfNames = ReadU32(directory + 24);
+    uint32_t functionsRva = ReadU32(directory + 28);
+    uint32_t namesRva = ReadU32(directory + 32);
+    uint32_t ordinalsRva = ReadU32(directory + 36);
+
+    if (numberOfFunctions > MaxOrdinals) {
+        numberOfFunctions = MaxOrdinals;
+    }
+
+    const uint8_t* functions = locate(functionsRva, available);
+    if (!functions || available / sizeof(uint32_t) < numberOfFunctions) {
+        return false;
+    }
+
+    const uint8_t* names = locate(namesRva, available);
+    if (!names || available / sizeof(uint32_t) < numberOfNames) {
+        numberOfNames = 0;
+    }
+
+    const uint8_t* ordinals = locate(ordinalsRva, available);
+    if (!ordinals || available / sizeof(uint16_t) < numberOfNames) {
+        numberOfNames = 0;
+    }
+
+    auto appendString = [&](uint32_t rva, uint32_t& offset, uint32_t& length) {
+        size_t span = 0;
+        const uint8_t* text = locate(rva, span);
+        const void* end = text ? std::memchr(text, '\0', span) : nullptr;
+        if (!end) {
+            return false;
+        }
+        offset = static_cast<uint32_t>(m_strings.size());
+        length = static_cast<uint32_t>(static_cast<const uint8_t*>(end) - text);
+        m_strings.insert(m_strings.end(), text, static_cast<const uint8_t*>(end));
+        return true;
+    };
+
+    std::vector<PendingSymbol> pending;
+    pending.reserve(static_cast<size_t>(numberOfNames) + numberOfFunctions);
+    m_ordinalSlots.assign(numberOfFunctions, EmptySlot);
+
+    auto append = [&](uint32_t index, uint32_t nameOffset, uint32_t nameLength) {
+        PendingSymbol symbol = { nameOffset, nameLength, 0, 0, static_cast<uint16_t>(base + index),
+            ReadU32(functions + index * sizeof(uint32_t)) };
+
+        if (symbol.rva >= directoryRva && symbol.rva - directoryRva < directorySize) {
+            appendString(symbol.rva, symbol.forwarderOffset, symbol.forwarderLength);
+        }
+
+        pending.push_back(symbol);
+        if (m_ordinalSlots[index] == EmptySlot) {
+            m_ordinalSlots[index] = static_cast<uint32_t>(pending.size());
+        }
+    };
+
+    for (uint32_t i = 0; i < numberOfNames; i++) {
+        uint16_t index = ReadU16(ordinals + i * sizeof(uint16_t));
+        if (index >= numberOfFunctions) {
+            continue;
+        }
+
+        uint32_t nameOffset = 0;
+        uint32_t nameLength = 0;
+        if (!appendString(ReadU32(names + i * sizeof(uint32_t)), nameOffset, nameLength)) {
+            continue;
+        }
+        append(index, nameOffset, nameLength);
+    }
+
+    for (uint32_t i = 0; i < numberOfFunctions; i++) {
+        if (m_ordinalSlots[i] == EmptySlot && ReadU32(functions + i * sizeof(uint32_t)) != 0) {
+            append(i, 0, 0);
+        }
+    }
+
+    m_ordinalBase = base;
+    m_symbols.reserve(pending.size());
+    for (const auto& symbol : pending) {
+        const char* strings = m_strings.data();
+        m_symbols.push_back(pe::ExportSymbol{
+            std::string_view(strings + symbol.nameOffset, symbol.nameLength),
+            symbol.ordinal,
+            symbol.rva,
+            std::string_view(strings + symbol.forwarderOffset, symbol.forwarderLength)
+        });
+    }
+
+    BuildNameTable();
+    return true;
+}
+
+uint32_t ExportIndex::HashName(std::string_view name) {
+    uint32_t hash = 2166136261u;
+    for (char c : name) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void ExportIndex::BuildNameTable() {
+    size_t named = 0;
+    for (const auto& symbol : m_symbols) {
+        if (!symbol.name.empty()) {
+            named++;
+        }
+    }
+
+    if (named == 0) {
+        return;
+    }
+
+    size_t capacity = 16;
+    while (capacity < named * 2) {
+        capacity <<= 1;
+    }
+
+    m_nameSlots.assign(capacity, EmptySlot);
+    const size_t mask = capacity - 1;
+
+    for (size_t i = 0; i < m_symbols.size(); i++) {
+        std::string_view name = m_symbols[i].name;
+        if (name.empty()) {
+            continue;
+        }
+
+        size_t slot = HashName(name) & mask;
+        while (m_nameSlots[slot] != EmptySlot && m_symbols[m_nameSlots[slot] - 1].name != name) {
+            slot = (slot + 1) & mask;
+        }
+        if (m_nameSlots[slot] == EmptySlot) {
+            m_nameSlots[slot] = static_cast<uint32_t>(i + 1);
+        }
+    }
+}
+
+const pe::ExportSymbol* ExportIndex::FindByName(std::string_view name) const {
+    if (m_nameSlots.empty() || name.empty()) {
+        return nullptr;
+    }
+
+    const size_t mask = m_nameSlots.size() - 1;
+    for (size_t slot = HashName(name) & mask; m_nameSlots[slot] != EmptySlot; slot = (slot + 1) & mask) {
+        const pe::ExportSymbol& symbol = m_symbols[m_nameSlots[slot] - 1];
+        if (symbol.name == name) {
+            return &symbol;
+        }
+    }
+    return nullptr;
+}
+
+const pe::ExportSymbol* ExportIndex::FindByOrdinal(uint16_t ordinal) const {
+    if (ordinal < m_ordinalBase) {
+        return nullptr;
+    }
+
+    size_t index = ordinal - m_ordinalBase;
+    if (index >= m_ordinalSlots.size() || m_ordinalSlots[index] == EmptySlot) {
+        return nullptr;
+    }
+    return &m_symbols[m_ordinalSlots[index] - 1];
+}
+
+const pe::ExportSymbol* ExportIndex::Resolve(
+    const pe::ExportSymbol* symbol,
+    const ModuleLookup& lookup,
+    const ExportIndex** owner,
+    int maxDepth
+) const {
+    const ExportIndex* current = this;
+
+    for (int depth = 0; symbol && symbol->IsForwarder() && depth < maxDepth; depth++) {
+        pe::ForwarderTarget target;
+        if (!pe::ParseForwarder(symbol->forwarder, target)) {
+            break;
+        }
+
+        const ExportIndex* next = lookup ? lookup(target.module) : nullptr;
+        if (!next) {
+            break;
+        }
+
+        current = next;
+        symbol = target.byOrdinal ? next->FindByOrdinal(target.ordinal) : next->FindByName(target.name);
+    }
+
+    if (owner) {
+        *owner = current;
+    }
+    return symbol;
+}
+
+}
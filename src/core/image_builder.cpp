@@ -0,0 +1,303 @@
+#include "core/image_builder.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define XORDLL_RELOC_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define XORDLL_TARGET_SSE2
+#define XORDLL_TARGET_AVX2
+#else
+#define XORDLL_TARGET_SSE2 __attribute__((target("sse2")))
+#define XORDLL_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace xordll {
+namespace pe {
+
+namespace {
+
+constexpr size_t RelocationBatch = 8;
+constexpr size_t PageSpan = 0x1000;
+
+using BatchKernel = bool (*)(uint8_t* page, const uint8_t* entries, uint64_t delta);
+
+inline bool PatchEntry(uint8_t* image, size_t imageSize, uint32_t pageRva, uint16_t entry, uint64_t delta,
+    size_t& applied) {
+    uint16_t type = entry >> 12;
+    size_t target = static_cast<size_t>(pageRva) + (entry & 0xFFF);
+
+    if (type == RelBasedDir64) {
+        if (target > imageSize || imageSize - target < sizeof(uint64_t)) {
+            return false;
+        }
+        uint64_t value;
+        std::memcpy(&value, image + target, sizeof(value));
+        value += delta;
+        std::memcpy(image + target, &value, sizeof(value));
+        applied++;
+    } else if (type == RelBasedHighLow) {
+        if (target > imageSize || imageSize - target < sizeof(uint32_t)) {
+            return false;
+        }
+        uint32_t value;
+        std::memcpy(&value, image + target, sizeof(value));
+        value += static_cast<uint32_t>(delta);
+        std::memcpy(image + target, &value, sizeof(value));
+        applied++;
+    }
+
+    return true;
+}
+
+bool ApplyScalar(uint8_t* image, size_t imageSize, const std::vector<RelocationBlock>& blocks, uint64_t delta,
+    size_t& applied) {
+    for (const auto& block : blocks) {
+        for (uint32_t i = 0; i < block.count; i++) {
+            if (!PatchEntry(image, imageSize, block.pageRva, block.Entry(i), delta, applied)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool ApplyBatched(BatchKernel batch, uint8_t* image, size_t imageSize, const std::vector<RelocationBlock>& blocks,
+    uint64_t delta, size_t& applied) {
+    for (const auto& block : blocks) {
+        uint32_t i = 0;
+
+        bool pageInBounds = static_cast<size_t>(block.pageRva) < imageSize &&
+            imageSize - block.pageRva >= PageSpan - 1 + sizeof(uint64_t);
+
+        if (pageInBounds) {
+            uint8_t* page = image + block.pageRva;
+
+            for (; i + RelocationBatch <= block.count; i += RelocationBatch) {
+                if (batch(page, block.entries + i * sizeof(uint16_t), delta)) {
+                    applied += RelocationBatch;
+                    continue;
+                }
+
+                for (uint32_t k = i; k < i + RelocationBatch; k++) {
+                    PatchEntry(image, imageSize, block.pageRva, block.Entry(k), delta, applied);
+                }
+            }
+        }
+
+        for (; i < block.count; i++) {
+            if (!PatchEntry(image, imageSize, block.pageRva, block.Entry(i), delta, applied)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+#ifdef XORDLL_RELOC_X86
+
+XORDLL_TARGET_SSE2 inline bool DecodeDir64Batch(const uint8_t* entries, __m128i& offsets) {
+    __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(entries));
+    __m128i types = _mm_srli_epi16(raw, 12);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(types, _mm_set1_epi16(RelBasedDir64))) != 0xFFFF) {
+        return false;
+    }
+
+    offsets = _mm_and_si128(raw, _mm_set1_epi16(0x0FFF));
+    __m128i gaps = _mm_sub_epi16(_mm_srli_si128(offsets, 2), offsets);
+    __m128i wide = _mm_cmpgt_epi16(gaps, _mm_set1_epi16(sizeof(uint64_t) - 1));
+    return (_mm_movemask_epi8(wide) & 0x3FFF) == 0x3FFF;
+}
+
+XORDLL_TARGET_SSE2 bool PatchBatchSse2(uint8_t* page, const uint8_t* entries, uint64_t delta) {
+    __m128i offsets;
+    if (!DecodeDir64Batch(entries, offsets)) {
+        return false;
+    }
+
+    alignas(16) uint16_t lanes[RelocationBatch];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), offsets);
+
+    __m128i add = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&delta));
+    for (size_t k = 0; k < RelocationBatch; k++) {
+        __m128i* slot = reinterpret_cast<__m128i*>(page + lanes[k]);
+        _mm_storel_epi64(slot, _mm_add_epi64(_mm_loadl_epi64(slot), add));
+    }
+    return true;
+}
+
+XORDLL_TARGET_AVX2 bool PatchBatchAvx2(uint8_t* page, const uint8_t* entries, uint64_t delta) {
+    __m128i offsets;
+    if (!DecodeDir64Batch(entries, offsets)) {
+        return false;
+    }
+
+    __m256i index = _mm256_cvtepu16_epi32(offsets);
+    __m256i add = _mm256_set1_epi64x(static_cast<long long>(delta));
+    const long long* base = reinterpret_cast<const long long*>(page);
+
+    __m256i low = _mm256_i32gather_epi64(base, _mm256_castsi256_si128(index), 1);
+    __m256i high = _mm256_i32gather_epi64(base, _mm256_extracti128_si256(index, 1), 1);
+
+    alignas(32) uint64_t values[RelocationBatch];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(values), _mm256_add_epi64(low, add));
+    _mm256_store_si256(reinterpret_cast<__m256i*>(values + 4), _mm256_add_epi64(high, add));
+
+    alignas(16) uint16_t lanes[RelocationBatch];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), offsets);
+
+    for (size_t k = 0; k < RelocationBatch; k++) {
+        std::memcpy(page + lanes[k], &values[k], sizeof(uint64_t));
+    }
+    return true;
+}
+
+bool CpuSupportsSse2() {
+#if defined(_M_X64) || defined(__x86_64__)
+    return true;
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2") != 0;
+#endif
+}
+
+bool CpuSupportsAvx2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif
+
+}
+
+bool IsRelocationKernelSupported(RelocationKernel kernel) {
+    switch (kernel) {
+        case RelocationKernel::Scalar:
+            return true;
+#ifdef XORDLL_RELOC_X86
+        case RelocationKernel::Sse2: {
+            static const bool supported = CpuSupportsSse2();
+            return supported;
+        }
+        case RelocationKernel::Avx2: {
+            static const bool supported = CpuSupportsAvx2();
+            return supported;
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+RelocationKernel GetRelocationKernel() {
+    if (IsRelocationKernelSupported(RelocationKernel::Sse2)) {
+        return RelocationKernel::Sse2;
+    }
+    return RelocationKernel::Scalar;
+}
+
+bool LayoutImage(const PeImage& image, std::vector<uint8_t>& out) {
+    if (!image.IsValid() || image.SizeOfImage() == 0) {
+        return false;
+    }
+
+    out.assign(image.SizeOfImage(), 0);
+
+    size_t headerSize = std::min<size_t>({ image.SizeOfHeaders(), image.Size(), out.size() });
+    std::memcpy(out.data(), image.Data(), headerSize);
+
+    for (const auto& section : image.Sections()) {
+        if (section.rawDataSize == 0) {
+            continue;
+        }
+
+        if (section.rawDataOffset >= image.Size() || section.virtualAddress >= out.size()) {
+            return false;
+        }
+
+        size_t copySize = section.rawDataSize;
+        copySize = std::min<size_t>(copySize, image.Size() - section.rawDataOffset);
+        copySize = std::min<size_t>(copySize, out.size() - section.virtualAddress);
+        if (section.virtualSize != 0) {
+            copySize = std::min<size_t>(copySize, section.virtualSize);
+        }
+
+        std::memcpy(out.data() + section.virtualAddress, image.Data() + section.rawDataOffset, copySize);
+    }
+
+    return true;
+}
+
+bool ApplyRelocations(
+    uint8_t* image,
+    size_t imageSize,
+    const std::vector<RelocationBlock>& blocks,
+    uint64_t delta,
+    size_t* appliedCount
+) {
+    static const RelocationKernel kernel = GetRelocationKernel();
+    return ApplyRelocations(kernel, image, imageSize, blocks, delta, appliedCount);
+}
+
+bool ApplyRelocations(
+    RelocationKernel kernel,
+    uint8_t* image,
+    size_t imageSize,
+    const std::vector<RelocationBlock>& blocks,
+    uint64_t delta,
+    size_t* appliedCount
+) {
+    size_t applied = 0;
+    bool ok = false;
+
+    if (!IsRelocationKernelSupported(kernel)) {
+        kernel = RelocationKernel::Scalar;
+    }
+
+    switch (kernel) {
+#ifdef XORDLL_RELOC_X86
+        case RelocationKernel::Sse2:
+            ok = ApplyBatched(PatchBatchSse2, image, imageSize, blocks, delta, applied);
+            break;
+        case RelocationKernel::Avx2:
+            ok = ApplyBatched(PatchBatchAvx2, image, imageSize, blocks, delta, applied);
+            break;
+#endif
+        default:
+            ok = ApplyScalar(image, imageSize, blocks, delta, applied);
+            break;
+    }
+
+    if (appliedCount) {
+        *appliedCount = applied;
+    }
+    return ok;
+}
+
+}
+}
@@ -2,10 +2,12 @@
 
 #include "core/injection_core.h"
 #include "core/process_manager.h"
+#include "core/process_enumerator.h"
 #include "core/manual_map.h"
 #include "core/thread_hijack.h"
 #include "utils/string_utils.h"
 #include "utils/file_utils.h"
+#include "utils/mapped_file.h"
 #include "utils/logger.h"
 
 namespace xordll {
@@ -29,13 +31,24 @@ InjectionResult InjectionCore::Inject(
     InjectionMethod method,
     ProgressCallback progressCallback
 ) {
-    Log(LogLevel::Info, L"Starting injection into PID " + std::to_wstring(pid));
-    Log(LogLevel::Info, L"DLL: " + dllPath);
-    Log(LogLevel::Info, L"Method: " + GetMethodName(method));
+    if (IsLogEnabled(LogLevel::Info)) {
+        Log(LogLevel::Info, L"Starting injection into PID " + std::to_wstring(pid));
+        Log(LogLevel::Info, L"DLL: " + dllPath);
+        Log(LogLevel::Info, L"Method: " + GetMethodName(method));
+    }
     
      
+    utils::MappedFile dllFile;
+    if (!dllFile.Open(dllPath)) {
+        return InjectionResult::Failure(ERROR_FILE_NOT_FOUND, L"Invalid or missing DLL file");
+    }
+    
+    PeImage dllImage(dllFile.Data(), dllFile.Size());
     DllInfo dllInfo;
-    if (!ValidateDll(dllPath, dllInfo)) {
+    dllInfo.path = dllPath;
+    dllInfo.name = utils::GetFileName(dllPath);
+    dllInfo.fileSize = dllFile.Size();
+    if (!ValidateDll(dllImage, dllInfo)) {
         return InjectionResult::Failure(ERROR_FILE_NOT_FOUND, L"Invalid or missing DLL file");
     }
     
@@ -72,7 +85,7 @@ InjectionResult InjectionCore::Inject(
         progressCallback(10, L"Preparing injection...");
     }
     
-    InjectionResult result = injectionMethod->Inject(hProcess, dllPath, progressCallback);
+    InjectionResult result = injectionMethod->InjectImage(hProcess, dllPath, dllImage, progressCallback);
     
     CloseHandle(hProcess);
     
@@ -90,7 +103,7 @@ InjectionResult InjectionCore::Eject(
     ModuleHandle moduleHandle,
     InjectionMethod method
 ) {
-    Log(LogLevel::Info, L"Starting ejection from PID " + std::to_wstring(pid));
+    Log(LogLevel::Info, [&] { return L"Starting ejection from PID " + std::to_wstring(pid); });
     
     HANDLE hProcess = ProcessManager::OpenProcessHandle(pid,
         PROCESS_CREATE_THREAD | PROCESS_QUERY_INFORMATION |
@@ -185,35 +198,30 @@ bool InjectionCore::ValidateDll(const std::wstring& dllPath, DllInfo& info)
     
     info.path = dllPath;
     info.name = utils::GetFileName(dllPath);
-    info.fileSize = utils::GetFileSize(dllPath);
     
      
-    std::vector<BYTE> data;
-    if (!utils::ReadFileToMemory(dllPath, data) || data.size() < sizeof(IMAGE_DOS_HEADER)) {
+    utils::MappedFile file;
+    if (!file.Open(dllPath)) {
         return false;
     }
+    info.fileSize = file.Size();
     
-    auto dosHeader = reinterpret_cast<IMAGE_DOS_HEADER*>(data.data());
-    if (dosHeader->e_magic != IMAGE_DOS_SIGNATURE) {
-        return false;
-    }
-    
-    if (data.size() < static_cast<size_t>(dosHeader->e_lfanew) + sizeof(IMAGE_NT_HEADERS)) {
-        return false;
-    }
-    
-    auto ntHeaders = reinterpret_cast<IMAGE_NT_HEADERS*>(data.data() + dosHeader->e_lfanew);
-    if (ntHeaders->Signature != IMAGE_NT_SIGNATURE) {
+    return ValidateDll(PeImage(file.Data(), file.Size()), info);
+}
+
+bool InjectionCore::ValidateDll(const PeImage& image, DllInfo& info)
+{
+    if (!image.IsValid()) {
         return false;
     }
     
      
-    if (!(ntHeaders->FileHeader.Characteristics & IMAGE_FILE_DLL)) {
+    if (!image.IsDll()) {
         return false;
     }
     
      
-    info.is64Bit = (ntHeaders->FileHeader.Machine == IMAGE_FILE_MACHINE_AMD64);
+    info.is64Bit = (image.Machine() == IMAGE_FILE_MACHINE_AMD64);
     
     return true;
 }
@@ -256,6 +264,11 @@ void InjectionCore::Log(LogLevel level, const std::wstring& message)
     }
 }
 
+bool InjectionCore::IsLogEnabled(LogLevel level) const
+{
+    return IsLogLevelCompiled(level) && (m_logCallback || Logger::Instance().IsEnabled(level));
+}
+
  
  
  
@@ -648,33 +661,29 @@ InjectionResult QueueUserAPCInjection::Inject(
     DWORD processId = GetProcessId(processHandle);
     
      
-    HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
-    if (hSnapshot == INVALID_HANDLE_VALUE) {
+    ProcessEnumeration enumeration;
+    if (!ProcessEnumerator::EnumerateShared(enumeration, true)) {
         VirtualFreeEx(processHandle, remoteMem, 0, MEM_RELEASE);
-        return InjectionResult::Failure(GetLastError(), L"Failed to create thread snapshot");
+        return InjectionResult::Failure(GetLastError(), L"Failed to enumerate threads");
     }
     
-    THREADENTRY32 te32 = { 0 };
-    te32.dwSize = sizeof(te32);
-    
     int apcQueued = 0;
     
-    if (Thread32First(hSnapshot, &te32)) {
-        do {
-            if (te32.th32OwnerProcessID == processId) {
-                HANDLE hThread = OpenThread(THREAD_SET_CONTEXT, FALSE, te32.th32ThreadID);
-                if (hThread) {
-                    if (QueueUserAPC(loadLibraryAddr, hThread, reinterpret_cast<ULONG_PTR>(remoteMem))) {
-                        apcQueued++;
-                    }
-                    CloseHandle(hThread);
+    for (const ProcessRecord& record : enumeration.processes) {
+        if (record.pid != processId) continue;
+        
+        for (uint32_t i = 0; i < record.threadCount; i++) {
+            HANDLE hThread = OpenThread(THREAD_SET_CONTEXT, FALSE, enumeration.threadIds[record.firstThread + i]);
+            if (hThread) {
+                if (QueueUserAPC(loadLibraryAddr, hThread, reinterpret_cast<ULONG_PTR>(remoteMem))) {
+                    apcQueued++;
                 }
+                CloseHandle(hThread);
             }
-        } while (Thread32Next(hSnapshot, &te32));
+        }
+        break;
     }
     
-    CloseHandle(hSnapshot);
-    
     if (progressCallback) progressCallback(100, L"APC queued to " + std::to_wstring(apcQueued) + L" threads");
     
     if (apcQueued == 0) {
@@ -726,22 +735,27 @@ InjectionResult ManualMapInjection::Inject(
     HANDLE processHandle,
     const std::wstring& dllPath,
     ProgressCallback progressCallback
+) {
+    utils::MappedFile file;
+    if (!file.Open(dllPath)) {
+        return InjectionResult::Failure(GetLastError(), L"Failed to read DLL file: " + dllPath);
+    }
+    
+    return InjectImage(processHandle, dllPath, PeImage(file.Data(), file.Size()), progressCallback);
+}
+
+InjectionResult ManualMapInjection::InjectImage(
+    HANDLE processHandle,
+    const std::wstring&,
+    const PeImage& image,
+    ProgressCallback progressCallback
 ) {
     if (progressCallback) progressCallback(10, L"Initializing manual mapper...");
     
     ManualMapper mapper;
-    mapper.SetLogCallback([](LogLevel level, const std::wstring& msg) {
-        switch (level) {
-            case LogLevel::Debug: LOG_DEBUG(msg); break;
-            case LogLevel::Info: LOG_INFO(msg); break;
-            case LogLevel::Warning: LOG_WARNING(msg); break;
-            case LogLevel::Error: LOG_ERROR(msg); break;
-        }
-    });
-    
     if (progressCallback) progressCallback(30, L"Parsing PE headers...");
     
-    ManualMapResult mapResult = mapper.Map(processHandle, dllPath, ManualMapFlags::Default);
+    ManualMapResult mapResult = mapper.MapImage(processHandle, image, ManualMapFlags::Default);
     
     if (!mapResult.success) {
         return InjectionResult::Failure(mapResult.errorCode, mapResult.errorMessage);
@@ -811,15 +825,6 @@ InjectionResult ThreadHijackInjection::Inject(
     }
     
     ThreadHijacker hijacker;
-    hijacker.SetLogCallback([](LogLevel level, const std::wstring& msg) {
-        switch (level) {
-            case LogLevel::Debug: LOG_DEBUG(msg); break;
-            case LogLevel::Info: LOG_INFO(msg); break;
-            case LogLevel::Warning: LOG_WARNING(msg); break;
-            case LogLevel::Error: LOG_ERROR(msg); break;
-        }
-    });
-    
     if (progressCallback) progressCallback(30, L"Hijacking thread...");
     
     InjectionResult result = hijacker.Inject(processId, dllPath);
@@ -37,7 +37,9 @@ bool ProfileManager::Load(const std::wstring& path) {
     buffer << file.rdbuf();
     std::string json = buffer.str();
     
-    return ProfileSerializer::FromJsonArray(json, m_profiles);
+    bool loaded = ProfileSerializer::FromJsonArray(json, m_profiles);
+    RebuildMatcher();
+    return loaded;
 }
 
 bool ProfileManager::Save(const std::wstring& path) {
@@ -67,6 +69,7 @@ bool ProfileManager::Save(const std::wstring& path) {
 std::wstring ProfileManager::AddProfile(const InjectionProfile& profile) {
     std::wstring id = GenerateId();
     m_profiles[id] = profile;
+    RebuildMatcher();
     return id;
 }
 
@@ -74,12 +77,13 @@ bool ProfileManager::RemoveProfile(const std::wstring& id) {
     auto it = m_profiles.find(id);
     if (it != m_profiles.end()) {
         m_profiles.erase(it);
+        RebuildMatcher();
         return true;
     }
     return false;
 }
 
-InjectionProfile* ProfileManager::GetProfile(const std::wstring& id) {
+const InjectionProfile* ProfileManager::GetProfile(const std::wstring& id) const {
     auto it = m_profiles.find(id);
     if (it != m_profiles.end()) {
         return &it->second;
@@ -87,8 +91,8 @@ InjectionProfile* ProfileManager::GetProfile(const std::wstring& id) {
     return nullptr;
 }
 
-InjectionProfile* ProfileManager::GetProfileByName(const std::wstring& name) {
-    for (auto& pair : m_profiles) {
+const InjectionProfile* ProfileManager::GetProfileByName(const std::wstring& name) const {
+    for (const auto& pair : m_profiles) {
         if (pair.second.name == name) {
             return &pair.second;
         }
@@ -96,28 +100,35 @@ InjectionProfile* ProfileManager::GetProfileByName(const std::wstring& name) {
     return nullptr;
 }
 
-std::vector<InjectionProfile*> ProfileManager::GetProfilesForProcess(const std::wstring& processName) {
-    std::vector<InjectionProfile*> result;
-    std::wstring lowerName = utils::ToLower(processName);
+std::vector<const InjectionProfile*> ProfileManager::GetProfilesForProcess(const std::wstring& processName) const {
+    std::vector<const InjectionProfile*> result;
+    m_matcher.ForEachMatch(processName, [&](uint32_t index) {
+        result.push_back(m_matcherProfiles[index]);
+    });
+    
+    return result;
+}
+
+void ProfileManager::RebuildMatcher() {
+    std::vector<std::wstring> patterns;
+    patterns.reserve(m_profiles.size());
+    m_matcherProfiles.clear();
     
     for (auto& pair : m_profiles) {
-        std::wstring targetLower = utils::ToLower(pair.second.targetProcess);
+        const std::wstring& target = pair.second.targetProcess;
         
          
-        if (targetLower == lowerName || 
-            utils::ContainsIgnoreCase(lowerName, targetLower) ||
-            utils::ContainsIgnoreCase(targetLower, L"*")) {
-            result.push_back(&pair.second);
-        }
+        patterns.push_back(WatchMatcher::IsGlob(target) ? target : L"*" + target + L"*");
+        m_matcherProfiles.push_back(&pair.second);
     }
     
-    return result;
+    m_matcher.Build(patterns);
 }
 
-std::vector<InjectionProfile*> ProfileManager::GetAutoInjectProfiles() {
-    std::vector<InjectionProfile*> result;
+std::vector<const InjectionProfile*> ProfileManager::GetAutoInjectProfiles() const {
+    std::vector<const InjectionProfile*> result;
     
-    for (auto& pair : m_profiles) {
+    for (const auto& pair : m_profiles) {
         if (pair.second.autoInject) {
             result.push_back(&pair.second);
         }
@@ -130,6 +141,7 @@ bool ProfileManager::UpdateProfile(const std::wstring& id, const InjectionProfil
     auto it = m_profiles.find(id);
     if (it != m_profiles.end()) {
         it->second = profile;
+        RebuildMatcher();
         return true;
     }
     return false;
@@ -1,9 +1,13 @@
  
 
 #include "core/manual_map.h"
+#include "core/image_builder.h"
+#include "utils/logger.h"
 #include "utils/string_utils.h"
-#include "utils/file_utils.h"
+#include "utils/mapped_file.h"
 #include <tlhelp32.h>
+#include <algorithm>
+#include <cstring>
 
 namespace xordll {
 
@@ -12,8 +16,7 @@ namespace xordll {
  
 
 ManualMapper::ManualMapper()
-    : m_dosHeader(nullptr)
-    , m_ntHeaders(nullptr)
+    : m_image(nullptr)
     , m_remoteBase(nullptr)
     , m_imageSize(0)
 {
@@ -29,36 +32,59 @@ ManualMapResult ManualMapper::Map(
     ManualMapResult result = { false, nullptr, 0, L"", 0 };
     
      
-    std::vector<BYTE> dllData;
-    if (!utils::ReadFileToMemory(dllPath, dllData)) {
+    utils::MappedFile file;
+    if (!file.Open(dllPath)) {
         result.errorMessage = L"Failed to read DLL file: " + dllPath;
         result.errorCode = GetLastError();
         Log(LogLevel::Error, result.errorMessage);
         return result;
     }
     
-    Log(LogLevel::Info, L"Read DLL file: " + std::to_wstring(dllData.size()) + L" bytes");
+    Log(LogLevel::Info, [&] { return L"Mapped DLL file: " + std::to_wstring(file.Size()) + L" bytes"; });
     
-    return MapFromMemory(processHandle, dllData, flags);
+    PeImage image(file.Data(), file.Size());
+    return MapImage(processHandle, image, flags);
 }
 
 ManualMapResult ManualMapper::MapFromMemory(
     HANDLE processHandle,
     const std::vector<BYTE>& dllData,
     ManualMapFlags flags
+) {
+    PeImage image(dllData.data(), dllData.size());
+    return MapImage(processHandle, image, flags);
+}
+
+ManualMapResult ManualMapper::MapImage(
+    HANDLE processHandle,
+    const PeImage& image,
+    ManualMapFlags flags
 ) {
     ManualMapResult result = { false, nullptr, 0, L"", 0 };
     
-    m_dllData = dllData;
-    
-     
-    if (!ParsePEHeaders(m_dllData)) {
+    if (!image.IsValid()) {
         result.errorMessage = L"Failed to parse PE headers";
         result.errorCode = ERROR_BAD_FORMAT;
         Log(LogLevel::Error, result.errorMessage);
         return result;
     }
     
+    m_image = &image;
+    m_imageSize = image.SizeOfImage();
+    
+    result = MapImageInternal(processHandle, flags);
+    ReleaseImage();
+    return result;
+}
+
+void ManualMapper::ReleaseImage() {
+    m_image = nullptr;
+    std::vector<BYTE>().swap(m_localImage);
+}
+
+ManualMapResult ManualMapper::MapImageInternal(HANDLE processHandle, ManualMapFlags flags) {
+    ManualMapResult result = { false, nullptr, 0, L"", 0 };
+    
      
     if (!ValidatePEHeaders()) {
         result.errorMessage = L"Invalid PE file";
@@ -67,8 +93,9 @@ ManualMapResult ManualMapper::MapFromMemory(
         return result;
     }
     
-    Log(LogLevel::Info, L"PE headers validated, image size: " + 
-        std::to_wstring(m_ntHeaders->OptionalHeader.SizeOfImage) + L" bytes");
+    Log(LogLevel::Info, [&] {
+        return L"PE headers validated, image size: " + std::to_wstring(m_image->SizeOfImage()) + L" bytes";
+    });
     
      
     if (!AllocateMemory(processHandle, flags)) {
@@ -78,24 +105,23 @@ ManualMapResult ManualMapper::MapFromMemory(
         return result;
     }
     
-    Log(LogLevel::Info, L"Allocated memory at: 0x" + 
-        utils::Utf8ToWide(std::to_string(reinterpret_cast<uintptr_t>(m_remoteBase))));
+    Log(LogLevel::Info, [&] {
+        return L"Allocated memory at: 0x" + utils::Utf8ToWide(std::to_string(reinterpret_cast<uintptr_t>(m_remoteBase)));
+    });
     
      
-    if (!CopySections(processHandle)) {
-        result.errorMessage = L"Failed to copy sections";
-        result.errorCode = GetLastError();
+    if (!BuildLocalImage()) {
+        result.errorMessage = L"Failed to lay out image sections";
+        result.errorCode = ERROR_BAD_FORMAT;
         VirtualFreeEx(processHandle, m_remoteBase, 0, MEM_RELEASE);
         Log(LogLevel::Error, result.errorMessage);
         return result;
     }
     
-    Log(LogLevel::Debug, L"Sections copied successfully");
-    
      
-    if (!ProcessRelocations(processHandle, m_remoteBase)) {
+    if (!ProcessRelocations(m_remoteBase)) {
         result.errorMessage = L"Failed to process relocations";
-        result.errorCode = GetLastError();
+        result.errorCode = ERROR_BAD_FORMAT;
         VirtualFreeEx(processHandle, m_remoteBase, 0, MEM_RELEASE);
         Log(LogLevel::Error, result.errorMessage);
         return result;
@@ -115,6 +141,17 @@ ManualMapResult ManualMapper::MapFromMemory(
     Log(LogLevel::Debug, L"Imports resolved");
     
      
+    if (!CopySections(processHandle)) {
+        result.errorMessage = L"Failed to copy sections";
+        result.errorCode = GetLastError();
+        VirtualFreeEx(processHandle, m_remoteBase, 0, MEM_RELEASE);
+        Log(LogLevel::Error, result.errorMessage);
+        return result;
+    }
+    
+    Log(LogLevel::Debug, L"Sections copied successfully");
+    
+     
     if (flags & ManualMapFlags::HandleTLS) {
         if (!HandleTLSCallbacks(processHandle)) {
             Log(LogLevel::Warning, L"TLS callback handling failed (non-fatal)");
@@ -165,66 +202,24 @@ bool ManualMapper::Unmap(HANDLE processHandle, LPVOID baseAddress) {
  
  
 
-bool ManualMapper::ParsePEHeaders(const std::vector<BYTE>& data) {
-    if (data.size() < sizeof(IMAGE_DOS_HEADER)) {
-        return false;
-    }
-    
-    m_dosHeader = reinterpret_cast<PIMAGE_DOS_HEADER>(const_cast<BYTE*>(data.data()));
-    
-    if (m_dosHeader->e_magic != IMAGE_DOS_SIGNATURE) {
-        return false;
-    }
-    
-    if (data.size() < static_cast<size_t>(m_dosHeader->e_lfanew) + sizeof(IMAGE_NT_HEADERS)) {
-        return false;
-    }
-    
-    m_ntHeaders = reinterpret_cast<PIMAGE_NT_HEADERS>(
-        const_cast<BYTE*>(data.data()) + m_dosHeader->e_lfanew);
-    
-    if (m_ntHeaders->Signature != IMAGE_NT_SIGNATURE) {
-        return false;
-    }
-    
-     
-    m_sections.clear();
-    auto sectionHeader = IMAGE_FIRST_SECTION(m_ntHeaders);
-    
-    for (WORD i = 0; i < m_ntHeaders->FileHeader.NumberOfSections; i++) {
-        SectionInfo section;
-        section.name = std::string(reinterpret_cast<char*>(sectionHeader[i].Name), 8);
-        section.virtualAddress = sectionHeader[i].VirtualAddress;
-        section.virtualSize = sectionHeader[i].Misc.VirtualSize;
-        section.rawDataOffset = sectionHeader[i].PointerToRawData;
-        section.rawDataSize = sectionHeader[i].SizeOfRawData;
-        section.characteristics = sectionHeader[i].Characteristics;
-        m_sections.push_back(section);
-    }
-    
-    m_imageSize = m_ntHeaders->OptionalHeader.SizeOfImage;
-    
-    return true;
-}
-
 bool ManualMapper::ValidatePEHeaders() {
-    if (!m_dosHeader || !m_ntHeaders) return false;
+    if (!m_image || !m_image->IsValid()) return false;
     
      
 #ifdef _WIN64
-    if (m_ntHeaders->FileHeader.Machine != IMAGE_FILE_MACHINE_AMD64) {
+    if (m_image->Machine() != IMAGE_FILE_MACHINE_AMD64) {
         Log(LogLevel::Error, L"DLL architecture mismatch: expected x64");
         return false;
     }
 #else
-    if (m_ntHeaders->FileHeader.Machine != IMAGE_FILE_MACHINE_I386) {
+    if (m_image->Machine() != IMAGE_FILE_MACHINE_I386) {
         Log(LogLevel::Error, L"DLL architecture mismatch: expected x86");
         return false;
     }
 #endif
     
      
-    if (!(m_ntHeaders->FileHeader.Characteristics & IMAGE_FILE_DLL)) {
+    if (!m_image->IsDll()) {
         Log(LogLevel::Error, L"File is not a DLL");
         return false;
     }
@@ -233,7 +228,7 @@ bool ManualMapper::ValidatePEHeaders() {
 }
 
 bool ManualMapper::Is64BitPE() const {
-    return m_ntHeaders && m_ntHeaders->FileHeader.Machine == IMAGE_FILE_MACHINE_AMD64;
+    return m_image && m_image->Machine() == IMAGE_FILE_MACHINE_AMD64;
 }
 
  
@@ -242,7 +237,7 @@ bool ManualMapper::Is64BitPE() const {
 
 bool ManualMapper::AllocateMemory(HANDLE hProcess, ManualMapFlags flags) {
     LPVOID preferredBase = reinterpret_cast<LPVOID>(
-        m_ntHeaders->OptionalHeader.ImageBase);
+        static_cast<ULONG_PTR>(m_image->ImageBase()));
     
      
     m_remoteBase = VirtualAllocEx(
@@ -267,22 +262,47 @@ bool ManualMapper::AllocateMemory(HANDLE hProcess, ManualMapFlags flags) {
     return m_remoteBase != nullptr;
 }
 
+bool ManualMapper::BuildLocalImage() {
+    return pe::LayoutImage(*m_image, m_localImage);
+}
+
+bool ManualMapper::ProcessRelocations(LPVOID newBase) {
+    ULONGLONG delta = reinterpret_cast<ULONGLONG>(newBase) - m_image->ImageBase();
+    
+    if (delta == 0) {
+         
+        return true;
+    }
+    
+    size_t applied = 0;
+    if (!pe::ApplyRelocations(m_localImage.data(), m_localImage.size(),
+        m_image->GetRelocations(), delta, &applied)) {
+        Log(LogLevel::Error, L"Relocation target outside of image");
+        return false;
+    }
+    
+    Log(LogLevel::Debug, [&] { return L"Applied " + std::to_wstring(applied) + L" relocations"; });
+    return true;
+}
+
 bool ManualMapper::CopySections(HANDLE hProcess) {
      
+    SIZE_T headerSize = std::min<SIZE_T>(m_image->SizeOfHeaders(), m_localImage.size());
     SIZE_T written;
-    if (!WriteProcessMemory(hProcess, m_remoteBase, m_dllData.data(),
-        m_ntHeaders->OptionalHeader.SizeOfHeaders, &written)) {
+    if (!WriteProcessMemory(hProcess, m_remoteBase, m_localImage.data(), headerSize, &written)) {
         return false;
     }
     
      
-    for (const auto& section : m_sections) {
-        if (section.rawDataSize == 0) continue;
+    for (const auto& section : m_image->Sections()) {
+        SIZE_T sectionSize = section.virtualSize ? section.virtualSize : section.rawDataSize;
+        if (sectionSize == 0 || section.virtualAddress >= m_localImage.size()) continue;
         
+        sectionSize = std::min<SIZE_T>(sectionSize, m_localImage.size() - section.virtualAddress);
         LPVOID sectionDest = reinterpret_cast<BYTE*>(m_remoteBase) + section.virtualAddress;
-        LPCVOID sectionSrc = m_dllData.data() + section.rawDataOffset;
+        LPCVOID sectionSrc = m_localImage.data() + section.virtualAddress;
         
-        if (!WriteProcessMemory(hProcess, sectionDest, sectionSrc, section.rawDataSize, &written)) {
+        if (!WriteProcessMemory(hProcess, sectionDest, sectionSrc, sectionSize, &written)) {
             Log(LogLevel::Error, L"Failed to copy section: " + utils::Utf8ToWide(section.name));
             return false;
         }
@@ -291,144 +311,83 @@ bool ManualMapper::CopySections(HANDLE hProcess) {
     return true;
 }
 
-bool ManualMapper::ProcessRelocations(HANDLE hProcess, LPVOID newBase) {
-    auto& dataDir = m_ntHeaders->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_BASERELOC];
-    
-    if (dataDir.Size == 0) {
-         
-        return true;
-    }
-    
-    ULONGLONG delta = reinterpret_cast<ULONGLONG>(newBase) - 
-                      m_ntHeaders->OptionalHeader.ImageBase;
-    
-    if (delta == 0) {
-         
+bool ManualMapper::ResolveImports(HANDLE hProcess) {
+    std::vector<pe::ImportModule> imports = m_image->GetImports();
+    if (imports.empty()) {
         return true;
     }
     
-    auto relocBase = reinterpret_cast<PIMAGE_BASE_RELOCATION>(
-        m_dllData.data() + dataDir.VirtualAddress);
-    
-    while (relocBase->VirtualAddress) {
-        DWORD numEntries = (relocBase->SizeOfBlock - sizeof(IMAGE_BASE_RELOCATION)) / sizeof(WORD);
-        auto relocEntry = reinterpret_cast<WORD*>(relocBase + 1);
-        
-        for (DWORD i = 0; i < numEntries; i++) {
-            WORD type = relocEntry[i] >> 12;
-            WORD offset = relocEntry[i] & 0xFFF;
-            
-            if (type == IMAGE_REL_BASED_ABSOLUTE) continue;
-            
-            LPVOID patchAddr = reinterpret_cast<BYTE*>(m_remoteBase) + 
-                               relocBase->VirtualAddress + offset;
-            
-            if (type == IMAGE_REL_BASED_HIGHLOW || type == IMAGE_REL_BASED_DIR64) {
-                 
-                ULONGLONG value = 0;
-                SIZE_T bytesRead;
-                size_t valueSize = (type == IMAGE_REL_BASED_DIR64) ? 8 : 4;
-                
-                if (!ReadProcessMemory(hProcess, patchAddr, &value, valueSize, &bytesRead)) {
-                    continue;
-                }
-                
-                 
-                value += delta;
-                
-                 
-                SIZE_T bytesWritten;
-                WriteProcessMemory(hProcess, patchAddr, &value, valueSize, &bytesWritten);
-            }
-        }
-        
-        relocBase = reinterpret_cast<PIMAGE_BASE_RELOCATION>(
-            reinterpret_cast<BYTE*>(relocBase) + relocBase->SizeOfBlock);
-    }
-    
-    return true;
-}
-
-bool ManualMapper::ResolveImports(HANDLE hProcess) {
-    auto& dataDir = m_ntHeaders->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_IMPORT];
-    
-    if (dataDir.Size == 0) {
-        return true;   
+     
+    m_remoteModules.clear();
+    if (!SnapshotRemoteModules(hProcess)) {
+        Log(LogLevel::Error, L"Failed to enumerate target modules: " + GetLastErrorMessage());
+        return false;
     }
     
-    auto importDesc = reinterpret_cast<PIMAGE_IMPORT_DESCRIPTOR>(
-        m_dllData.data() + dataDir.VirtualAddress);
+    const size_t pointerSize = Is64BitPE() ? sizeof(ULONGLONG) : sizeof(DWORD);
+    size_t resolved = 0;
     
-    while (importDesc->Name) {
-        const char* moduleName = reinterpret_cast<const char*>(
-            m_dllData.data() + importDesc->Name);
+    for (const auto& module : imports) {
+        const std::string& moduleName = module.name;
         
-        Log(LogLevel::Debug, L"Resolving imports from: " + utils::Utf8ToWide(moduleName));
+        Log(LogLevel::Debug, [&] { return L"Resolving imports from: " + utils::Utf8ToWide(moduleName); });
         
-         
-        HMODULE hRemoteModule = GetRemoteModuleHandle(hProcess, moduleName);
+        RemoteModule* remote = FindRemoteModule(moduleName);
         
-        if (!hRemoteModule) {
+        if (!remote) {
              
             if (!LoadRemoteModule(hProcess, moduleName)) {
                 Log(LogLevel::Error, L"Failed to load module: " + utils::Utf8ToWide(moduleName));
                 return false;
             }
-            hRemoteModule = GetRemoteModuleHandle(hProcess, moduleName);
+            SnapshotRemoteModules(hProcess);
+            remote = FindRemoteModule(moduleName);
         }
         
-        if (!hRemoteModule) {
+        if (!remote) {
             Log(LogLevel::Error, L"Module not found: " + utils::Utf8ToWide(moduleName));
             return false;
         }
         
-         
-        auto thunk = reinterpret_cast<PIMAGE_THUNK_DATA>(
-            m_dllData.data() + importDesc->FirstThunk);
-        auto origThunk = importDesc->OriginalFirstThunk ?
-            reinterpret_cast<PIMAGE_THUNK_DATA>(m_dllData.data() + importDesc->OriginalFirstThunk) :
-            thunk;
-        
-        LPVOID iatEntry = reinterpret_cast<BYTE*>(m_remoteBase) + importDesc->FirstThunk;
-        
-        while (origThunk->u1.AddressOfData) {
-            FARPROC funcAddr = nullptr;
-            
-            if (IMAGE_SNAP_BY_ORDINAL(origThunk->u1.Ordinal)) {
-                 
-                WORD ordinal = IMAGE_ORDINAL(origThunk->u1.Ordinal);
-                funcAddr = GetRemoteProcAddress(hProcess, hRemoteModule, 
-                    reinterpret_cast<const char*>(ordinal));
-            } else {
-                 
-                auto importByName = reinterpret_cast<PIMAGE_IMPORT_BY_NAME>(
-                    m_dllData.data() + origThunk->u1.AddressOfData);
-                funcAddr = GetRemoteProcAddress(hProcess, hRemoteModule, importByName->Name);
-            }
+        for (const auto& function : module.functions) {
+            ULONG_PTR funcAddr = ResolveRemoteExport(hProcess, *remote, function);
             
             if (!funcAddr) {
-                Log(LogLevel::Warning, L"Failed to resolve import function");
+                Log(LogLevel::Warning, [&] {
+                    return L"Failed to resolve import: " + utils::Utf8ToWide(moduleName) + L"!" +
+                        (function.byOrdinal ? L"#" + std::to_wstring(function.ordinal) : utils::Utf8ToWide(function.name));
+                });
+            } else {
+                resolved++;
             }
             
              
-            SIZE_T written;
-            WriteProcessMemory(hProcess, iatEntry, &funcAddr, sizeof(funcAddr), &written);
+            if (function.iatRva > m_localImage.size() || m_localImage.size() - function.iatRva < pointerSize) {
+                Log(LogLevel::Error, L"Import address table outside of image");
+                return false;
+            }
             
-            thunk++;
-            origThunk++;
-            iatEntry = reinterpret_cast<BYTE*>(iatEntry) + sizeof(LPVOID);
+            BYTE* iatEntry = m_localImage.data() + function.iatRva;
+            if (pointerSize == sizeof(ULONGLONG)) {
+                ULONGLONG value = funcAddr;
+                memcpy(iatEntry, &value, sizeof(value));
+            } else {
+                DWORD value = static_cast<DWORD>(funcAddr);
+                memcpy(iatEntry, &value, sizeof(value));
+            }
         }
-        
-        importDesc++;
     }
     
+    Log(LogLevel::Debug, [&] {
+        return L"Resolved " + std::to_wstring(resolved) + L" imports from " +
+            std::to_wstring(imports.size()) + L" modules";
+    });
+    
     return true;
 }
 
 bool ManualMapper::HandleTLSCallbacks(HANDLE hProcess) {
-    auto& dataDir = m_ntHeaders->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_TLS];
-    
-    if (dataDir.Size == 0) {
+    if (m_image->Directory(pe::DirectoryTls).size == 0) {
         return true;   
     }
     
@@ -440,7 +399,7 @@ bool ManualMapper::HandleTLSCallbacks(HANDLE hProcess) {
 }
 
 bool ManualMapper::SetSectionProtections(HANDLE hProcess) {
-    for (const auto& section : m_sections) {
+    for (const auto& section : m_image->Sections()) {
         DWORD protection = PAGE_READONLY;
         
         if (section.characteristics & IMAGE_SCN_MEM_EXECUTE) {
@@ -463,10 +422,9 @@ bool ManualMapper::SetSectionProtections(HANDLE hProcess) {
 }
 
 bool ManualMapper::ExecuteDllMain(HANDLE hProcess, DWORD reason) {
-    LPVOID entryPoint = reinterpret_cast<BYTE*>(m_remoteBase) + 
-                        m_ntHeaders->OptionalHeader.AddressOfEntryPoint;
+    LPVOID entryPoint = reinterpret_cast<BYTE*>(m_remoteBase) + m_image->EntryPointRva();
     
-    if (m_ntHeaders->OptionalHeader.AddressOfEntryPoint == 0) {
+    if (m_image->EntryPointRva() == 0) {
         Log(LogLevel::Debug, L"No entry point, skipping DllMain");
         return true;
     }
@@ -518,7 +476,7 @@ bool ManualMapper::ExecuteDllMain(HANDLE hProcess, DWORD reason) {
 
 bool ManualMapper::CleanupHeaders(HANDLE hProcess, ManualMapFlags flags) {
      
-    std::vector<BYTE> zeros(m_ntHeaders->OptionalHeader.SizeOfHeaders, 0);
+    std::vector<BYTE> zeros(m_image->SizeOfHeaders(), 0);
     SIZE_T written;
     
     return WriteProcessMemory(hProcess, m_remoteBase, zeros.data(), zeros.size(), &written) != FALSE;
@@ -528,42 +486,115 @@ bool ManualMapper::CleanupHeaders(HANDLE hProcess, ManualMapFlags flags) {
  
  
 
-HMODULE ManualMapper::GetRemoteModuleHandle(HANDLE hProcess, const std::string& moduleName) {
+bool ManualMapper::SnapshotRemoteModules(HANDLE hProcess) {
     HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPMODULE | TH32CS_SNAPMODULE32,
         GetProcessId(hProcess));
     
     if (hSnapshot == INVALID_HANDLE_VALUE) {
-        return nullptr;
+        return false;
     }
     
     MODULEENTRY32W me = { sizeof(me) };
-    HMODULE result = nullptr;
     
     if (Module32FirstW(hSnapshot, &me)) {
         do {
-            std::wstring modName = me.szModule;
-            if (_wcsicmp(modName.c_str(), utils::Utf8ToWide(moduleName).c_str()) == 0) {
-                result = me.hModule;
-                break;
+             
+            RemoteModule& module = m_remoteModules[utils::ToLower(me.szModule)];
+            ULONG_PTR base = reinterpret_cast<ULONG_PTR>(me.modBaseAddr);
+            if (module.base != base) {
+                module = RemoteModule();
+                module.base = base;
+                module.size = me.modBaseSize;
             }
         } while (Module32NextW(hSnapshot, &me));
     }
     
     CloseHandle(hSnapshot);
-    return result;
+    return true;
 }
 
-FARPROC ManualMapper::GetRemoteProcAddress(HANDLE hProcess, HMODULE hModule, const std::string& funcName) {
-     
+ManualMapper::RemoteModule* ManualMapper::FindRemoteModule(const std::string& moduleName) {
+    std::wstring key = utils::ToLower(utils::Utf8ToWide(moduleName));
+    if (key.find(L'.') == std::wstring::npos) {
+        key += L".dll";
+    }
+    
+    auto it = m_remoteModules.find(key);
+    return it != m_remoteModules.end() ? &it->second : nullptr;
+}
+
+bool ManualMapper::ParseRemoteExports(HANDLE hProcess, RemoteModule& module) {
+    module.exportsParsed = true;
+    
      
+    BYTE headers[0x1000];
+    SIZE_T read = 0;
+    if (!ReadProcessMemory(hProcess, reinterpret_cast<LPCVOID>(module.base), headers, sizeof(headers), &read)) {
+        return false;
+    }
+    
+    PeImage image(headers, read);
+    pe::DataDirectory dir = image.Directory(pe::DirectoryExport);
+    if (!image.IsValid() || dir.virtualAddress == 0 || dir.size == 0 || dir.virtualAddress >= module.size ||
+        module.size - dir.virtualAddress < dir.size) {
+        return false;
+    }
+    
+    std::vector<BYTE> exportData(dir.size);
+    if (!ReadProcessMemory(hProcess, reinterpret_cast<LPCVOID>(module.base + dir.virtualAddress),
+        exportData.data(), exportData.size(), &read) || read != exportData.size()) {
+        return false;
+    }
+    
+    return module.exports.Build(exportData.data(), exportData.size(), dir.virtualAddress);
+}
+
+ULONG_PTR ManualMapper::ResolveRemoteExport(HANDLE hProcess, RemoteModule& module, const pe::ImportFunction& function) {
+    if (!module.exportsParsed) {
+        ParseRemoteExports(hProcess, module);
+    }
+    
+    const pe::ExportSymbol* symbol = function.byOrdinal ?
+        module.exports.FindByOrdinal(function.ordinal) :
+        module.exports.FindByName(function.name);
     
      
-    HMODULE hLocalModule = GetModuleHandleA(nullptr);
+    const RemoteModule* owner = &module;
+    symbol = module.exports.Resolve(symbol, [&](const std::string& moduleName) -> const ExportIndex* {
+        RemoteModule* target = FindRemoteModule(moduleName);
+        if (!target) {
+            return nullptr;
+        }
+        if (!target->exportsParsed) {
+            ParseRemoteExports(hProcess, *target);
+        }
+        owner = target;
+        return &target->exports;
+    });
+    
+    if (!symbol) {
+        return 0;
+    }
+    
+    if (!symbol->IsForwarder()) {
+        return owner->base + symbol->rva;
+    }
     
      
-    FARPROC localFunc = GetProcAddress(hModule, funcName.c_str());
+    pe::ForwarderTarget target;
+    if (!pe::ParseForwarder(symbol->forwarder, target)) {
+        return 0;
+    }
     
-    return localFunc;
+    HMODULE hLocal = GetModuleHandleA(target.module.c_str());
+    if (!hLocal) {
+        return 0;
+    }
+    
+    FARPROC localFunc = target.byOrdinal ?
+        GetProcAddress(hLocal, reinterpret_cast<LPCSTR>(static_cast<ULONG_PTR>(target.ordinal))) :
+        GetProcAddress(hLocal, target.name.c_str());
+    return reinterpret_cast<ULONG_PTR>(localFunc);
 }
 
 bool ManualMapper::LoadRemoteModule(HANDLE hProcess, const std::string& moduleName) {
@@ -611,9 +642,15 @@ bool ManualMapper::LoadRemoteModule(HANDLE hProcess, const std::string& moduleNa
 void ManualMapper::Log(LogLevel level, const std::wstring& message) {
     if (m_logCallback) {
         m_logCallback(level, L"[ManualMap] " + message);
+    } else if (Logger::Instance().IsEnabled(level)) {
+        Logger::Instance().Log(level, L"[ManualMap] " + message);
     }
 }
 
+bool ManualMapper::IsLogEnabled(LogLevel level) const {
+    return IsLogLevelCompiled(level) && (m_logCallback || Logger::Instance().IsEnabled(level));
+}
+
 std::wstring ManualMapper::GetLastErrorMessage() {
     return utils::FormatWindowsError(GetLastError());
 }
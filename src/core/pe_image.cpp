@@ -0,0 +1,435 @@
+#include "core/pe_image.h"
+#include <algorithm>
+
+namespace xordll {
+
+namespace {
+
+constexpr size_t DosLfanewOffset = 0x3C;
+constexpr size_t FileHeaderSize = 20;
+constexpr size_t SectionHeaderSize = 40;
+constexpr size_t ImportDescriptorSize = 20;
+constexpr size_t RelocationHeaderSize = 8;
+
+constexpr uint64_t OrdinalFlag64 = 0x8000000000000000ULL;
+constexpr uint32_t OrdinalFlag32 = 0x80000000;
+
+}
+
+PeImage::PeImage() {
+    Reset();
+}
+
+PeImage::PeImage(const uint8_t* data, size_t size) {
+    Parse(data, size);
+}
+
+void PeImage::Reset() {
+    m_data = nullptr;
+    m_size = 0;
+    m_valid = false;
+    m_machine = 0;
+    m_characteristics = 0;
+    m_is64Bit = false;
+    m_imageBase = 0;
+    m_sizeOfImage = 0;
+    m_sizeOfHeaders = 0;
+    m_entryPoint = 0;
+    m_directories.clear();
+    m_sections.clear();
+    m_rvaRanges.clear();
+    m_offsetRanges.clear();
+}
+
+bool PeImage::Parse(const uint8_t* data, size_t size) {
+    Reset();
+
+    if (!data) {
+        return false;
+    }
+
+    m_data = data;
+    m_size = size;
+
+    uint16_t dosMagic = 0;
+    if (!ReadAt(0, dosMagic) || dosMagic != pe::DosSignature) {
+        return false;
+    }
+
+    int32_t lfanew = 0;
+    if (!ReadAt(DosLfanewOffset, lfanew) || lfanew < 0) {
+        return false;
+    }
+
+    size_t ntOffset = static_cast<size_t>(lfanew);
+    uint32_t signature = 0;
+    if (!ReadAt(ntOffset, signature) || signature != pe::NtSignature) {
+        return false;
+    }
+
+    size_t fileHeader = ntOffset + sizeof(uint32_t);
+    uint16_t numberOfSections = 0;
+    uint16_t sizeOfOptionalHeader = 0;
+    if (!ReadAt(fileHeader, m_machine) ||
+        !ReadAt(fileHeader + 2, numberOfSections) ||
+        !ReadAt(fileHeader + 16, sizeOfOptionalHeader) ||
+        !ReadAt(fileHeader + 18, m_characteristics)) {
+        return false;
+    }
+
+    size_t optional = fileHeader + FileHeaderSize;
+    uint16_t magic = 0;
+    if (!ReadAt(optional, magic)) {
+        return false;
+    }
+
+    size_t numberOfRvaOffset = 0;
+    size_t directoryOffset = 0;
+
+    if (magic == pe::OptionalMagic64) {
+        m_is64Bit = true;
+        if (!ReadAt(optional + 24, m_imageBase)) {
+            return false;
+        }
+        numberOfRvaOffset = optional + 108;
+        directoryOffset = optional + 112;
+    } else if (magic == pe::OptionalMagic32) {
+        uint32_t imageBase32 = 0;
+        if (!ReadAt(optional + 28, imageBase32)) {
+            return false;
+        }
+        m_imageBase = imageBase32;
+        numberOfRvaOffset = optional + 92;
+        directoryOffset = optional + 96;
+    } else {
+        return false;
+    }
+
+    uint32_t numberOfRvaAndSizes = 0;
+    if (!ReadAt(optional + 16, m_entryPoint) ||
+        !ReadAt(optional + 56, m_sizeOfImage) ||
+        !ReadAt(optional + 60, m_sizeOfHeaders) ||
+        !ReadAt(numberOfRvaOffset, numberOfRvaAndSizes)) {
+        return false;
+    }
+
+    if (directoryOffset - optional > sizeOfOptionalHeader) {
+        return false;
+    }
+
+    size_t maxDirectories = (sizeOfOptionalHeader - (directoryOffset - optional)) / sizeof(pe::DataDirectory);
+    if (numberOfRvaAndSizes > maxDirectories) {
+        numberOfRvaAndSizes = static_cast<uint32_t>(maxDirectories);
+    }
+    if (numberOfRvaAndSizes > pe::DirectoryCount) {
+        numberOfRvaAndSizes = pe::DirectoryCount;
+    }
+
+    m_directories.assign(pe::DirectoryCount, pe::DataDirectory{ 0, 0 });
+    for (uint32_t i = 0; i < numberOfRvaAndSizes; i++) {
+        size_t entry = directoryOffset + i * sizeof(pe::DataDirectory);
+        if (!ReadAt(entry, m_directories[i].virtualAddress) ||
+            !ReadAt(entry + 4, m_directories[i].size)) {
+            return false;
+        }
+    }
+
+    size_t sectionTable = optional + sizeOfOptionalHeader;
+    if (sectionTable > m_size || (m_size - sectionTable) / SectionHeaderSize < numberOfSections) {
+        return false;
+    }
+
+    m_sections.reserve(numberOfSections);
+    for (uint16_t i = 0; i < numberOfSections; i++) {
+        const uint8_t* header = m_data + sectionTable + i * SectionHeaderSize;
+
+        pe::Section section;
+        const char* name = reinterpret_cast<const char*>(header);
+        size_t nameLen = 0;
+        while (nameLen < 8 && name[nameLen] != '\0') {
+            nameLen++;
+        }
+        section.name.assign(name, nameLen);
+
+        std::memcpy(&section.virtualSize, header + 8, sizeof(uint32_t));
+        std::memcpy(&section.virtualAddress, header + 12, sizeof(uint32_t));
+        std::memcpy(&section.rawDataSize, header + 16, sizeof(uint32_t));
+        std::memcpy(&section.rawDataOffset, header + 20, sizeof(uint32_t));
+        std::memcpy(&section.characteristics, header + 36, sizeof(uint32_t));
+
+        m_sections.push_back(section);
+    }
+
+    BuildAddressMaps();
+
+    m_valid = true;
+    return true;
+}
+
+pe::DataDirectory PeImage::Directory(uint32_t index) const {
+    if (index >= m_directories.size()) {
+        return pe::DataDirectory{ 0, 0 };
+    }
+    return m_directories[index];
+}
+
+void PeImage::BuildAddressMaps() {
+    const uint32_t headerEnd = m_sizeOfHeaders;
+
+    m_rvaRanges.clear();
+    m_rvaRanges.reserve(m_sections.size() + 1);
+    if (headerEnd > 0) {
+        m_rvaRanges.push_back(AddressRange{ 0, headerEnd, 0 });
+    }
+
+    for (const auto& section : m_sections) {
+        uint64_t start = section.virtualAddress;
+        uint64_t end = std::min<uint64_t>(start + section.rawDataSize, UINT32_MAX);
+        uint64_t target = section.rawDataOffset;
+
+        if (start < headerEnd) {
+            target += headerEnd - start;
+            start = headerEnd;
+        }
+        if (start >= end) {
+            continue;
+        }
+
+        m_rvaRanges.push_back(AddressRange{
+            static_cast<uint32_t>(start),
+            static_cast<uint32_t>(end),
+            static_cast<uint32_t>(std::min<uint64_t>(target, UINT32_MAX))
+        });
+    }
+
+    auto byStart = [](const AddressRange& a, const AddressRange& b) { return a.start < b.start; };
+    std::stable_sort(m_rvaRanges.begin(), m_rvaRanges.end(), byStart);
+
+    for (size_t i = 0; i + 1 < m_rvaRanges.size(); i++) {
+        m_rvaRanges[i].end = std::min(m_rvaRanges[i].end, m_rvaRanges[i + 1].start);
+    }
+
+    m_offsetRanges.clear();
+    m_offsetRanges.reserve(m_rvaRanges.size());
+    for (const auto& range : m_rvaRanges) {
+        uint32_t length = range.end - range.start;
+        if (length == 0 || range.target >= m_size) {
+            continue;
+        }
+        uint64_t end = static_cast<uint64_t>(range.target) + length;
+        m_offsetRanges.push_back(AddressRange{
+            range.target,
+            static_cast<uint32_t>(std::min<uint64_t>(end, m_size)),
+            range.start
+        });
+    }
+
+    std::stable_sort(m_offsetRanges.begin(), m_offsetRanges.end(), byStart);
+
+    for (size_t i = 0; i + 1 < m_offsetRanges.size(); i++) {
+        m_offsetRanges[i].end = std::min(m_offsetRanges[i].end, m_offsetRanges[i + 1].start);
+    }
+}
+
+const PeImage::AddressRange* PeImage::FindRange(const std::vector<AddressRange>& ranges, uint32_t key) {
+    size_t count = ranges.size();
+    if (count == 0 || key < ranges[0].start) {
+        return nullptr;
+    }
+
+    const AddressRange* base = ranges.data();
+    while (count > 1) {
+        size_t half = count / 2;
+        base = (base[half].start <= key) ? base + half : base;
+        count -= half;
+    }
+
+    return key < base->end ? base : nullptr;
+}
+
+bool PeImage::LocateRva(uint32_t rva, uint32_t& offset, size_t& available) const {
+    const AddressRange* range = FindRange(m_rvaRanges, rva);
+    if (!range) {
+        return false;
+    }
+
+    uint64_t fileOffset = static_cast<uint64_t>(range->target) + (rva - range->start);
+    if (fileOffset >= m_size) {
+        return false;
+    }
+
+    offset = static_cast<uint32_t>(fileOffset);
+    available = std::min<size_t>(range->end - rva, m_size - offset);
+    return true;
+}
+
+bool PeImage::OffsetToRva(uint32_t offset, uint32_t& rva) const {
+    const AddressRange* range = FindRange(m_offsetRanges, offset);
+    if (!range) {
+        return false;
+    }
+
+    rva = range->target + (offset - range->start);
+    return true;
+}
+
+bool PeImage::RvaToOffset(uint32_t rva, uint32_t& offset) const {
+    size_t available = 0;
+    return LocateRva(rva, offset, available);
+}
+
+const uint8_t* PeImage::RvaToPointer(uint32_t rva, size_t length) const {
+    uint32_t offset = 0;
+    size_t available = 0;
+    if (!LocateRva(rva, offset, available) || length > available) {
+        return nullptr;
+    }
+    return m_data + offset;
+}
+
+const uint8_t* PeImage::RvaToSpan(uint32_t rva, size_t& available) const {
+    uint32_t offset = 0;
+    if (!LocateRva(rva, offset, available)) {
+        return nullptr;
+    }
+    return m_data + offset;
+}
+
+bool PeImage::ReadString(uint32_t rva, std::string& out) const {
+    uint32_t offset = 0;
+    size_t available = 0;
+    if (!LocateRva(rva, offset, available)) {
+        return false;
+    }
+
+    const char* str = reinterpret_cast<const char*>(m_data + offset);
+    const void* end = std::memchr(str, '\0', available);
+    if (!end) {
+        return false;
+    }
+
+    out.assign(str, static_cast<const char*>(end));
+    return true;
+}
+
+std::vector<pe::ImportModule> PeImage::GetImports() const {
+    std::vector<pe::ImportModule> imports;
+
+    pe::DataDirectory dir = Directory(pe::DirectoryImport);
+    if (!m_valid || dir.virtualAddress == 0 || dir.size == 0) {
+        return imports;
+    }
+
+    const size_t thunkSize = m_is64Bit ? sizeof(uint64_t) : sizeof(uint32_t);
+
+    for (uint32_t descRva = dir.virtualAddress;; descRva += ImportDescriptorSize) {
+        const uint8_t* desc = RvaToPointer(descRva, ImportDescriptorSize);
+        if (!desc) {
+            break;
+        }
+
+        uint32_t originalFirstThunk = 0;
+        uint32_t nameRva = 0;
+        uint32_t firstThunk = 0;
+        std::memcpy(&originalFirstThunk, desc, sizeof(uint32_t));
+        std::memcpy(&nameRva, desc + 12, sizeof(uint32_t));
+        std::memcpy(&firstThunk, desc + 16, sizeof(uint32_t));
+
+        if (nameRva == 0 || firstThunk == 0) {
+            break;
+        }
+
+        pe::ImportModule module;
+        if (!ReadString(nameRva, module.name)) {
+            break;
+        }
+
+        uint32_t lookupRva = originalFirstThunk ? originalFirstThunk : firstThunk;
+
+        for (uint32_t index = 0;; index++) {
+            uint32_t thunkRva = lookupRva + static_cast<uint32_t>(index * thunkSize);
+            uint32_t iatRva = firstThunk + static_cast<uint32_t>(index * thunkSize);
+
+            uint64_t value = 0;
+            bool byOrdinal = false;
+
+            if (m_is64Bit) {
+                if (!ReadRva(thunkRva, value)) {
+                    break;
+                }
+                byOrdinal = (value & OrdinalFlag64) != 0;
+            } else {
+                uint32_t value32 = 0;
+                if (!ReadRva(thunkRva, value32)) {
+                    break;
+                }
+                value = value32;
+                byOrdinal = (value32 & OrdinalFlag32) != 0;
+            }
+
+            if (value == 0) {
+                break;
+            }
+
+            pe::ImportFunction function;
+            function.ordinal = 0;
+            function.hint = 0;
+            function.byOrdinal = byOrdinal;
+            function.iatRva = iatRva;
+
+            if (byOrdinal) {
+                function.ordinal = static_cast<uint16_t>(value & 0xFFFF);
+            } else {
+                uint32_t byNameRva = static_cast<uint32_t>(value);
+                if (!ReadRva(byNameRva, function.hint) ||
+                    !ReadString(byNameRva + sizeof(uint16_t), function.name)) {
+                    break;
+                }
+            }
+
+            module.functions.push_back(std::move(function));
+        }
+
+        imports.push_back(std::move(module));
+    }
+
+    return imports;
+}
+
+std::vector<pe::RelocationBlock> PeImage::GetRelocations() const {
+    std::vector<pe::RelocationBlock> blocks;
+
+    pe::DataDirectory dir = Directory(pe::DirectoryBaseReloc);
+    if (!m_valid || dir.virtualAddress == 0 || dir.size == 0) {
+        return blocks;
+    }
+
+    const uint8_t* table = RvaToPointer(dir.virtualAddress, dir.size);
+    if (!table) {
+        return blocks;
+    }
+
+    size_t pos = 0;
+    while (dir.size - pos >= RelocationHeaderSize) {
+        uint32_t pageRva = 0;
+        uint32_t blockSize = 0;
+        std::memcpy(&pageRva, table + pos, sizeof(uint32_t));
+        std::memcpy(&blockSize, table + pos + 4, sizeof(uint32_t));
+
+        if (blockSize < RelocationHeaderSize || blockSize > dir.size - pos) {
+            break;
+        }
+
+        pe::RelocationBlock block;
+        block.pageRva = pageRva;
+        block.entries = table + pos + RelocationHeaderSize;
+        block.count = static_cast<uint32_t>((blockSize - RelocationHeaderSize) / sizeof(uint16_t));
+        blocks.push_back(block);
+
+        pos += blockSize;
+    }
+
+    return blocks;
+}
+
+}
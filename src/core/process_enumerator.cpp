@@ -0,0 +1,197 @@
+#include "core/process_enumerator.h"
+#include "utils/logger.h"
+#include <tlhelp32.h>
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
+namespace xordll {
+
+namespace {
+
+constexpr ULONG SystemProcessInformationClass = 5;
+constexpr LONG StatusInfoLengthMismatch = static_cast<LONG>(0xC0000004);
+constexpr size_t InitialBufferSize = 256 * 1024;
+constexpr int MaxQueryAttempts = 8;
+
+uint64_t QueryCreationTime(DWORD pid) {
+    HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+    if (!hProcess) {
+        return 0;
+    }
+
+    FILETIME creation, exitTime, kernel, user;
+    uint64_t result = 0;
+    if (GetProcessTimes(hProcess, &creation, &exitTime, &kernel, &user)) {
+        result = (static_cast<uint64_t>(creation.dwHighDateTime) << 32) | creation.dwLowDateTime;
+    }
+
+    CloseHandle(hProcess);
+    return result;
+}
+
+}
+
+std::unique_ptr<ProcessEnumerator> ProcessEnumerator::Create() {
+    auto nt = std::make_unique<NtProcessEnumerator>();
+    if (nt->IsAvailable()) {
+        return nt;
+    }
+
+    LOG_WARNING(L"NtQuerySystemInformation unavailable, falling back to Toolhelp32");
+    return std::make_unique<ToolhelpProcessEnumerator>();
+}
+
+bool ProcessEnumerator::EnumerateWithFallback(
+    std::unique_ptr<ProcessEnumerator>& enumerator,
+    ProcessEnumeration& out,
+    bool includeThreads
+) {
+    if (!enumerator) {
+        enumerator = Create();
+    }
+
+    if (enumerator->Enumerate(out, includeThreads)) {
+        return true;
+    }
+    if (enumerator->IsFallback()) {
+        return false;
+    }
+
+    LOG_WARNING(std::wstring(enumerator->Name()) + L" enumeration failed, falling back to Toolhelp32");
+    enumerator = std::make_unique<ToolhelpProcessEnumerator>();
+    return enumerator->Enumerate(out, includeThreads);
+}
+
+bool ProcessEnumerator::EnumerateShared(ProcessEnumeration& out, bool includeThreads) {
+    static std::mutex mutex;
+    static std::unique_ptr<ProcessEnumerator> shared;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return EnumerateWithFallback(shared, out, includeThreads);
+}
+
+ 
+ 
+ 
+
+NtProcessEnumerator::NtProcessEnumerator()
+    : m_query(nullptr)
+{
+    HMODULE hNtdll = GetModuleHandleW(L"ntdll.dll");
+    if (hNtdll) {
+        m_query = reinterpret_cast<NtQuerySystemInformationFn>(
+            GetProcAddress(hNtdll, "NtQuerySystemInformation"));
+    }
+}
+
+bool NtProcessEnumerator::Enumerate(ProcessEnumeration& out, bool includeThreads) {
+    if (!m_query) {
+        return false;
+    }
+
+    if (m_buffer.empty()) {
+        m_buffer.resize(InitialBufferSize);
+    }
+
+    for (int attempt = 0; attempt < MaxQueryAttempts; attempt++) {
+        ULONG needed = 0;
+        LONG status = m_query(SystemProcessInformationClass, m_buffer.data(),
+            static_cast<ULONG>(m_buffer.size()), &needed);
+
+        if (status == StatusInfoLengthMismatch) {
+            size_t grown = std::max<size_t>(m_buffer.size() * 2, needed + needed / 4);
+            m_buffer.resize(grown);
+            continue;
+        }
+
+        if (status < 0) {
+            wchar_t code[16];
+            swprintf_s(code, L"0x%08X", static_cast<ULONG>(status));
+            LOG_ERROR(L"NtQuerySystemInformation failed: " + std::wstring(code));
+            return false;
+        }
+
+        size_t size = needed ? std::min<size_t>(needed, m_buffer.size()) : m_buffer.size();
+        return ParseSystemProcessInformation(
+            m_buffer.data(),
+            size,
+            reinterpret_cast<uintptr_t>(m_buffer.data()),
+            sizeof(void*) == 8 ? PointerWidth::Bits64 : PointerWidth::Bits32,
+            includeThreads,
+            out
+        );
+    }
+
+    return false;
+}
+
+ 
+ 
+ 
+
+bool ToolhelpProcessEnumerator::Enumerate(ProcessEnumeration& out, bool includeThreads) {
+    DWORD flags = TH32CS_SNAPPROCESS | (includeThreads ? TH32CS_SNAPTHREAD : 0);
+    HANDLE hSnapshot = CreateToolhelp32Snapshot(flags, 0);
+    if (hSnapshot == INVALID_HANDLE_VALUE) {
+        LOG_WIN_ERROR(L"CreateToolhelp32Snapshot");
+        return false;
+    }
+
+    out.Clear();
+    std::unordered_map<DWORD, size_t> indexByPid;
+
+    PROCESSENTRY32W pe = { 0 };
+    pe.dwSize = sizeof(pe);
+    if (Process32FirstW(hSnapshot, &pe)) {
+        do {
+            ProcessRecord record;
+            record.pid = pe.th32ProcessID;
+            record.parentPid = pe.th32ParentProcessID;
+            record.imageName = pe.szExeFile;
+            record.creationTime = pe.th32ProcessID ? QueryCreationTime(pe.th32ProcessID) : 0;
+
+            indexByPid[record.pid] = out.processes.size();
+            out.processes.push_back(std::move(record));
+        } while (Process32NextW(hSnapshot, &pe));
+    }
+
+    if (includeThreads) {
+        std::vector<std::pair<DWORD, DWORD>> threads;
+
+        THREADENTRY32 te = { 0 };
+        te.dwSize = sizeof(te);
+        if (Thread32First(hSnapshot, &te)) {
+            do {
+                threads.emplace_back(te.th32OwnerProcessID, te.th32ThreadID);
+            } while (Thread32Next(hSnapshot, &te));
+        }
+
+
+        std::stable_sort(threads.begin(), threads.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        for (size_t i = 0; i < threads.size(); ) {
+            size_t end = i;
+            while (end < threads.size() && threads[end].first == threads[i].first) {
+                end++;
+            }
+
+            auto it = indexByPid.find(threads[i].first);
+            if (it != indexByPid.end()) {
+                ProcessRecord& record = out.processes[it->second];
+                record.firstThread = static_cast<uint32_t>(out.threadIds.size());
+                record.threadCount = static_cast<uint32_t>(end - i);
+                for (size_t j = i; j < end; j++) {
+                    out.threadIds.push_back(threads[j].second);
+                }
+            }
+            i = end;
+        }
+    }
+
+    CloseHandle(hSnapshot);
+    return true;
+}
+
+}
@@ -0,0 +1,161 @@
+#include "core/process_event_source.h"
+#include "utils/logger.h"
+#include <cstring>
+
+namespace xordll {
+
+namespace {
+
+constexpr wchar_t SessionPrefix[] = L"xorDLL-ProcessMonitor-";
+
+
+constexpr GUID KernelProcessProvider =
+    { 0x22fb2cd6, 0x0e7b, 0x422b, { 0xa0, 0xc7, 0x2f, 0xad, 0x1f, 0xd0, 0xe7, 0x16 } };
+
+constexpr ULONGLONG KeywordProcess = 0x10;
+constexpr USHORT EventProcessStart = 1;
+constexpr USHORT EventProcessStop = 2;
+
+EVENT_TRACE_PROPERTIES* PrepareProperties(std::vector<uint8_t>& buffer, const std::wstring& sessionName) {
+    buffer.assign(sizeof(EVENT_TRACE_PROPERTIES) + (sessionName.size() + 1) * sizeof(wchar_t), 0);
+
+    auto* properties = reinterpret_cast<EVENT_TRACE_PROPERTIES*>(buffer.data());
+    properties->Wnode.BufferSize = static_cast<ULONG>(buffer.size());
+    properties->Wnode.Flags = WNODE_FLAG_TRACED_GUID;
+    properties->Wnode.ClientContext = 1;
+    properties->LogFileMode = EVENT_TRACE_REAL_TIME_MODE;
+    properties->FlushTimer = 1;
+    properties->LoggerNameOffset = sizeof(EVENT_TRACE_PROPERTIES);
+    return properties;
+}
+
+}
+
+std::unique_ptr<ProcessEventSource> ProcessEventSource::Create() {
+    return std::make_unique<EtwProcessEventSource>();
+}
+
+ 
+ 
+ 
+
+EtwProcessEventSource::EtwProcessEventSource()
+    : m_sessionName(SessionPrefix + std::to_wstring(GetCurrentProcessId()))
+    , m_stopping(false)
+    , m_session(0)
+    , m_trace(INVALID_PROCESSTRACE_HANDLE)
+{
+}
+
+EtwProcessEventSource::~EtwProcessEventSource() {
+    Stop();
+}
+
+bool EtwProcessEventSource::Start(Sink sink, StopHandler onStopped) {
+    if (m_session) {
+        return true;
+    }
+
+    m_sink = std::move(sink);
+    m_onStopped = std::move(onStopped);
+    m_stopping = false;
+
+    EVENT_TRACE_PROPERTIES* properties = PrepareProperties(m_properties, m_sessionName);
+    ULONG status = StartTraceW(&m_session, m_sessionName.c_str(), properties);
+
+     
+    if (status == ERROR_ALREADY_EXISTS) {
+        ControlTraceW(0, m_sessionName.c_str(), properties, EVENT_TRACE_CONTROL_STOP);
+        properties = PrepareProperties(m_properties, m_sessionName);
+        status = StartTraceW(&m_session, m_sessionName.c_str(), properties);
+    }
+
+    if (status != ERROR_SUCCESS) {
+        LOG_WARNING(L"StartTrace failed: " + std::to_wstring(status));
+        m_session = 0;
+        return false;
+    }
+
+    status = EnableTraceEx2(m_session, &KernelProcessProvider, EVENT_CONTROL_CODE_ENABLE_PROVIDER,
+        TRACE_LEVEL_INFORMATION, KeywordProcess, 0, 0, nullptr);
+    if (status != ERROR_SUCCESS) {
+        LOG_WARNING(L"EnableTraceEx2 failed: " + std::to_wstring(status));
+        Stop();
+        return false;
+    }
+
+    EVENT_TRACE_LOGFILEW logFile = { 0 };
+    logFile.LoggerName = const_cast<LPWSTR>(m_sessionName.c_str());
+    logFile.ProcessTraceMode = PROCESS_TRACE_MODE_REAL_TIME | PROCESS_TRACE_MODE_EVENT_RECORD;
+    logFile.EventRecordCallback = &EtwProcessEventSource::OnEventRecord;
+    logFile.Context = this;
+
+    m_trace = OpenTraceW(&logFile);
+    if (m_trace == INVALID_PROCESSTRACE_HANDLE) {
+        LOG_WIN_ERROR(L"OpenTrace");
+        Stop();
+        return false;
+    }
+
+    m_thread = std::thread([this]() {
+        ULONG result = ProcessTrace(&m_trace, 1, nullptr, nullptr);
+        if (!m_stopping) {
+            LOG_WARNING(L"ProcessTrace ended unexpectedly: " + std::to_wstring(result));
+            if (m_onStopped) {
+                m_onStopped();
+            }
+        }
+    });
+
+    LOG_INFO(L"Process events from " + std::wstring(Name()));
+    return true;
+}
+
+void EtwProcessEventSource::Stop() {
+    m_stopping = true;
+
+    if (m_session) {
+        ControlTraceW(m_session, nullptr, PrepareProperties(m_properties, m_sessionName), EVENT_TRACE_CONTROL_STOP);
+        m_session = 0;
+    }
+
+    if (m_trace != INVALID_PROCESSTRACE_HANDLE) {
+        CloseTrace(m_trace);
+        m_trace = INVALID_PROCESSTRACE_HANDLE;
+    }
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void WINAPI EtwProcessEventSource::OnEventRecord(PEVENT_RECORD record) {
+    auto* source = static_cast<EtwProcessEventSource*>(record->UserContext);
+    if (!source || !source->m_sink) {
+        return;
+    }
+
+    if (!IsEqualGUID(record->EventHeader.ProviderId, KernelProcessProvider)) {
+        return;
+    }
+
+    USHORT id = record->EventHeader.EventDescriptor.Id;
+    if (id != EventProcessStart && id != EventProcessStop) {
+        return;
+    }
+
+     
+    if (record->UserDataLength < sizeof(uint32_t)) {
+        return;
+    }
+
+    uint32_t pid;
+    std::memcpy(&pid, record->UserData, sizeof(pid));
+
+    ProcessEventNotification notification;
+    notification.event = (id == EventProcessStart) ? ProcessEvent::Started : ProcessEvent::Terminated;
+    notification.pid = pid;
+    source->m_sink(notification);
+}
+
+}
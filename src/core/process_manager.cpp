@@ -8,21 +8,26 @@
 
 namespace xordll {
 
+const ProcessInfo* ProcessSnapshot::FindByPid(ProcessId pid) const
+{
+    auto it = pidIndex.find(pid);
+    return it != pidIndex.end() ? &processes[it->second] : nullptr;
+}
+
+std::vector<uint32_t> ProcessSnapshot::FilterByName(const std::wstring& filter) const
+{
+    return searchIndex.Find(filter);
+}
+
 ProcessManager::ProcessManager()
-    : m_isRefreshing(false)
+    : m_snapshot(std::make_shared<ProcessSnapshot>())
+    , m_enumerator(ProcessEnumerator::Create())
+    , m_isRefreshing(false)
 {
 }
 
 ProcessManager::~ProcessManager()
 {
-     
-    std::lock_guard<std::mutex> lock(m_mutex);
-    for (auto& proc : m_processes) {
-        if (proc.icon) {
-            DestroyIcon(proc.icon);
-            proc.icon = nullptr;
-        }
-    }
 }
 
 bool ProcessManager::RefreshProcessList()
@@ -31,31 +36,38 @@ bool ProcessManager::RefreshProcessList()
         return false;  
     }
     
-    std::vector<ProcessInfo> newProcesses;
+    auto snapshot = std::make_shared<ProcessSnapshot>();
+    std::vector<ProcessInfo>& newProcesses = snapshot->processes;
+    ProcessSnapshotPtr current = GetSnapshot();
+    const std::vector<ProcessInfo>& previousProcesses = current->processes;
     
      
-    HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-    if (hSnapshot == INVALID_HANDLE_VALUE) {
-        LOG_WIN_ERROR(L"CreateToolhelp32Snapshot");
+    if (!ProcessEnumerator::EnumerateWithFallback(m_enumerator, m_enumeration)) {
         m_isRefreshing = false;
         return false;
     }
     
-    PROCESSENTRY32W pe32 = { 0 };
-    pe32.dwSize = sizeof(pe32);
-    
-    if (Process32FirstW(hSnapshot, &pe32)) {
-        do {
-             
-            if (pe32.th32ProcessID == 0) continue;
-            
-            ProcessInfo info = CreateProcessInfo(pe32);
-            newProcesses.push_back(std::move(info));
-            
-        } while (Process32NextW(hSnapshot, &pe32));
-    }
+     
+    std::vector<bool> carried(previousProcesses.size(), false);
+    newProcesses.reserve(m_enumeration.processes.size());
     
-    CloseHandle(hSnapshot);
+    for (const ProcessRecord& record : m_enumeration.processes) {
+         
+        if (record.pid == 0) continue;
+        
+         
+        auto it = current->pidIndex.find(record.pid);
+        if (it != current->pidIndex.end() && !carried[it->second]) {
+            const ProcessInfo& existing = previousProcesses[it->second];
+            if (existing.creationTime == record.creationTime && existing.name == record.imageName) {
+                carried[it->second] = true;
+                newProcesses.push_back(existing);
+                continue;
+            }
+        }
+        
+        newProcesses.push_back(CreateProcessInfo(record));
+    }
     
      
     std::sort(newProcesses.begin(), newProcesses.end(),
@@ -63,46 +75,38 @@ bool ProcessManager::RefreshProcessList()
             return utils::ToLower(a.name) < utils::ToLower(b.name);
         });
     
-     
-    {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        
-         
-        for (auto& proc : m_processes) {
-            if (proc.icon) {
-                DestroyIcon(proc.icon);
-            }
-        }
-        
-        m_processes = std::move(newProcesses);
+    snapshot->searchIndex.Build(newProcesses, [](const ProcessInfo& proc) -> const std::wstring& { return proc.name; });
+    snapshot->pidIndex.reserve(newProcesses.size());
+    for (size_t i = 0; i < newProcesses.size(); i++) {
+        snapshot->pidIndex.emplace(newProcesses[i].pid, static_cast<uint32_t>(i));
     }
     
+     
+    size_t count = newProcesses.size();
+    std::atomic_store(&m_snapshot, ProcessSnapshotPtr(std::move(snapshot)));
+    
     m_isRefreshing = false;
-    LOG_DEBUG(L"Process list refreshed: " + std::to_wstring(m_processes.size()) + L" processes");
+    LOG_DEBUG(L"Process list refreshed: " + std::to_wstring(count) + L" processes");
     return true;
 }
 
+ProcessSnapshotPtr ProcessManager::GetSnapshot() const
+{
+    return std::atomic_load(&m_snapshot);
+}
+
 std::vector<ProcessInfo> ProcessManager::GetProcessList() const
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_processes;
+    return GetSnapshot()->processes;
 }
 
 std::vector<ProcessInfo> ProcessManager::FilterByName(const std::wstring& filter) const
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    
-    if (filter.empty()) {
-        return m_processes;
-    }
+    ProcessSnapshotPtr snapshot = GetSnapshot();
     
     std::vector<ProcessInfo> filtered;
-    std::wstring lowerFilter = utils::ToLower(filter);
-    
-    for (const auto& proc : m_processes) {
-        if (utils::ContainsIgnoreCase(proc.name, filter)) {
-            filtered.push_back(proc);
-        }
+    for (uint32_t index : snapshot->FilterByName(filter)) {
+        filtered.push_back(snapshot->processes[index]);
     }
     
     return filtered;
@@ -110,12 +114,10 @@ std::vector<ProcessInfo> ProcessManager::FilterByName(const std::wstring& filter
 
 std::optional<ProcessInfo> ProcessManager::FindByPid(ProcessId pid) const
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    
-    for (const auto& proc : m_processes) {
-        if (proc.pid == pid) {
-            return proc;
-        }
+    ProcessSnapshotPtr snapshot = GetSnapshot();
+    const ProcessInfo* proc = snapshot->FindByPid(pid);
+    if (proc) {
+        return *proc;
     }
     
     return std::nullopt;
@@ -128,11 +130,15 @@ bool ProcessManager::IsProcess64Bit(ProcessId pid)
         return false;
     }
     
-    BOOL isWow64 = FALSE;
-    BOOL result = IsWow64Process(hProcess, &isWow64);
+    bool is64Bit = QueryProcess64Bit(hProcess);
     CloseHandle(hProcess);
-    
-    if (!result) {
+    return is64Bit;
+}
+
+bool ProcessManager::QueryProcess64Bit(HANDLE hProcess)
+{
+    BOOL isWow64 = FALSE;
+    if (!IsWow64Process(hProcess, &isWow64)) {
         return false;
     }
     
@@ -162,19 +168,25 @@ std::wstring ProcessManager::GetProcessPath(ProcessId pid)
     
     HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
     if (hProcess) {
-        wchar_t buffer[MAX_PATH] = { 0 };
-        DWORD size = MAX_PATH;
-        
-        if (QueryFullProcessImageNameW(hProcess, 0, buffer, &size)) {
-            path = buffer;
-        }
-        
+        path = QueryProcessPath(hProcess);
         CloseHandle(hProcess);
     }
     
     return path;
 }
 
+std::wstring ProcessManager::QueryProcessPath(HANDLE hProcess)
+{
+    wchar_t buffer[MAX_PATH] = { 0 };
+    DWORD size = MAX_PATH;
+    
+    if (QueryFullProcessImageNameW(hProcess, 0, buffer, &size)) {
+        return std::wstring(buffer, size);
+    }
+    
+    return std::wstring();
+}
+
 HICON ProcessManager::GetProcessIcon(const std::wstring& path)
 {
     if (path.empty()) {
@@ -218,8 +230,7 @@ HANDLE ProcessManager::OpenProcessHandle(ProcessId pid, DWORD desiredAccess)
 
 size_t ProcessManager::GetProcessCount() const
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_processes.size();
+    return GetSnapshot()->processes.size();
 }
 
 bool ProcessManager::IsRunningAsAdmin()
@@ -265,14 +276,19 @@ bool ProcessManager::EnableDebugPrivilege()
     return result && error == ERROR_SUCCESS;
 }
 
-ProcessInfo ProcessManager::CreateProcessInfo(const PROCESSENTRY32W& entry)
+ProcessInfo ProcessManager::CreateProcessInfo(const ProcessRecord& record)
 {
     ProcessInfo info;
-    info.pid = entry.th32ProcessID;
-    info.name = entry.szExeFile;
-    info.path = GetProcessPath(entry.th32ProcessID);
-    info.is64Bit = IsProcess64Bit(entry.th32ProcessID);
-    info.icon = GetProcessIcon(info.path);
+    info.pid = record.pid;
+    info.name = record.imageName;
+    info.creationTime = record.creationTime;
+    
+    HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, record.pid);
+    if (hProcess) {
+        info.path = QueryProcessPath(hProcess);
+        info.is64Bit = QueryProcess64Bit(hProcess);
+        CloseHandle(hProcess);
+    }
     
     return info;
 }
@@ -4,11 +4,18 @@
 #include "core/injection_core.h"
 #include "core/process_manager.h"
 #include "utils/string_utils.h"
-#include <tlhelp32.h>
+#include "utils/logger.h"
 #include <algorithm>
+#include <chrono>
 
 namespace xordll {
 
+namespace {
+
+constexpr DWORD EventResyncInterval = 30000;
+
+}
+
  
  
  
@@ -16,6 +23,10 @@ namespace xordll {
 ProcessMonitor::ProcessMonitor()
     : m_running(false)
     , m_pollingInterval(1000)
+    , m_enumerator(ProcessEnumerator::Create())
+    , m_eventSource(ProcessEventSource::Create())
+    , m_eventSourceActive(false)
+    , m_eventSourceLost(false)
 {
 }
 
@@ -29,6 +40,38 @@ bool ProcessMonitor::Start() {
     }
     
     m_running = true;
+    
+     
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& pair : m_knownProcesses) {
+            if (IsWatched(pair.second.name)) {
+                TrackProcess(pair.first);
+            }
+        }
+    }
+    
+     
+    if (m_eventSource) {
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_eventSourceLost = false;
+        }
+        
+        bool started = m_eventSource->Start(
+            [this](const ProcessEventNotification& notification) { OnSourceEvent(notification); },
+            [this]() { OnSourceStopped(); });
+        
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_eventSourceActive = started && !m_eventSourceLost;
+        }
+        
+        if (!started) {
+            LOG_WARNING(std::wstring(m_eventSource->Name()) + L" unavailable, falling back to polling");
+        }
+    }
+    
     m_thread = std::thread(&ProcessMonitor::MonitorThread, this);
     
     return true;
@@ -39,26 +82,57 @@ void ProcessMonitor::Stop() {
         return;
     }
     
-    m_running = false;
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_running = false;
+    }
+    m_wakeCondition.notify_all();
+    
+    if (m_eventSource) {
+        m_eventSource->Stop();
+        m_eventSourceActive = false;
+    }
     
     if (m_thread.joinable()) {
         m_thread.join();
     }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        while (!m_waits.empty()) {
+            UntrackProcess(m_waits.begin()->first);
+        }
+    }
+    
+    m_pendingEvents.clear();
+}
+
+void ProcessMonitor::SetEventSource(std::unique_ptr<ProcessEventSource> source) {
+    if (m_running) {
+        return;
+    }
+    m_eventSource = std::move(source);
 }
 
 void ProcessMonitor::WatchProcess(const std::wstring& processName) {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_watchList.insert(utils::ToLower(processName));
+    RebuildMatcher();
+    RetrackWatchedProcesses();
 }
 
 void ProcessMonitor::UnwatchProcess(const std::wstring& processName) {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_watchList.erase(utils::ToLower(processName));
+    RebuildMatcher();
+    RetrackWatchedProcesses();
 }
 
 void ProcessMonitor::ClearWatchList() {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_watchList.clear();
+    RebuildMatcher();
+    RetrackWatchedProcesses();
 }
 
 std::vector<std::wstring> ProcessMonitor::GetWatchList() const {
@@ -70,96 +144,269 @@ void ProcessMonitor::MonitorThread() {
      
     CheckForNewProcesses();
     
+    std::vector<ProcessEventNotification> notifications;
+    auto nextPoll = std::chrono::steady_clock::now();
+    
     while (m_running) {
-        Sleep(m_pollingInterval);
+         
+        DWORD interval = m_eventSourceActive ? std::max<DWORD>(m_pollingInterval, EventResyncInterval) : m_pollingInterval;
+        nextPoll += std::chrono::milliseconds(interval);
         
-        if (!m_running) break;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(m_wakeMutex);
+                m_wakeCondition.wait_until(lock, nextPoll, [this]() {
+                    return !m_running || !m_pendingEvents.empty() || m_eventSourceLost;
+                });
+                
+                if (!m_running) return;
+                notifications.swap(m_pendingEvents);
+                if (m_eventSourceLost && notifications.empty()) {
+                    m_eventSourceLost = false;
+                    break;
+                }
+            }
+            
+            if (notifications.empty()) break;
+            
+            HandleNotifications(notifications);
+            notifications.clear();
+        }
         
         CheckForNewProcesses();
-        CheckForTerminatedProcesses();
+        nextPoll = std::chrono::steady_clock::now();
     }
 }
 
-void ProcessMonitor::CheckForNewProcesses() {
-    HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-    if (hSnapshot == INVALID_HANDLE_VALUE) {
-        return;
+void ProcessMonitor::OnSourceEvent(const ProcessEventNotification& notification) {
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        if (!m_running) return;
+        m_pendingEvents.push_back(notification);
     }
+    m_wakeCondition.notify_one();
+}
+
+void ProcessMonitor::OnSourceStopped() {
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        if (!m_running) return;
+        m_eventSourceActive = false;
+        m_eventSourceLost = true;
+    }
+    LOG_WARNING(std::wstring(m_eventSource->Name()) + L" stopped delivering events, falling back to polling");
+    m_wakeCondition.notify_one();
+}
+
+void ProcessMonitor::HandleNotifications(const std::vector<ProcessEventNotification>& notifications) {
+    bool resync = false;
     
-    PROCESSENTRY32W pe = { sizeof(pe) };
+    for (const ProcessEventNotification& notification : notifications) {
+        if (notification.event == ProcessEvent::Started) {
+            resync |= !HandleStarted(notification.pid);
+        } else {
+            HandleTerminated(notification.pid);
+        }
+    }
     
-    if (Process32FirstW(hSnapshot, &pe)) {
-        do {
-            ProcessId pid = pe.th32ProcessID;
-            std::wstring name = pe.szExeFile;
-            
-             
-            std::lock_guard<std::mutex> lock(m_mutex);
-            
-            if (m_knownProcesses.find(pid) == m_knownProcesses.end()) {
-                 
-                ProcessInfo info;
-                info.pid = pid;
-                info.name = name;
-                info.path = L"";   
-                
-                m_knownProcesses[pid] = info;
-                
-                 
-                if (IsWatched(name)) {
-                    if (m_callback) {
-                        m_callback(ProcessEvent::Started, info);
-                    }
-                }
-            }
-        } while (Process32NextW(hSnapshot, &pe));
+     
+    if (resync) {
+        CheckForNewProcesses();
+    }
+}
+
+bool ProcessMonitor::HandleStarted(ProcessId pid) {
+    HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+    if (!hProcess) {
+        return false;
+    }
+    
+    ProcessInfo info;
+    info.pid = pid;
+    
+    wchar_t path[MAX_PATH];
+    DWORD size = MAX_PATH;
+    if (QueryFullProcessImageNameW(hProcess, 0, path, &size)) {
+        info.path = path;
+        info.name = utils::GetFileName(info.path);
+    }
+    
+    FILETIME creation, exitTime, kernel, user;
+    if (GetProcessTimes(hProcess, &creation, &exitTime, &kernel, &user)) {
+        info.creationTime = (static_cast<uint64_t>(creation.dwHighDateTime) << 32) | creation.dwLowDateTime;
     }
     
-    CloseHandle(hSnapshot);
+    CloseHandle(hProcess);
+    
+    if (info.name.empty()) {
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    auto it = m_knownProcesses.find(pid);
+    if (it != m_knownProcesses.end()) {
+        if (it->second.creationTime == info.creationTime) {
+            return true;
+        }
+        RemoveKnownProcess(it);
+    }
+    
+    AddKnownProcess(info);
+    return true;
 }
 
-void ProcessMonitor::CheckForTerminatedProcesses() {
+void ProcessMonitor::HandleTerminated(ProcessId pid) {
     std::lock_guard<std::mutex> lock(m_mutex);
     
-    std::vector<ProcessId> terminated;
+    auto it = m_knownProcesses.find(pid);
+    if (it != m_knownProcesses.end()) {
+        RemoveKnownProcess(it);
+    }
+}
+
+void ProcessMonitor::CheckForNewProcesses() {
+    if (!ProcessEnumerator::EnumerateWithFallback(m_enumerator, m_enumeration)) {
+        return;
+    }
     
-    for (const auto& pair : m_knownProcesses) {
-        HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pair.first);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    m_livePids.clear();
+    
+    for (const ProcessRecord& record : m_enumeration.processes) {
+        m_livePids.push_back(record.pid);
         
-        if (!hProcess) {
-             
-            terminated.push_back(pair.first);
-            
-            if (IsWatched(pair.second.name)) {
-                if (m_callback) {
-                    m_callback(ProcessEvent::Terminated, pair.second);
-                }
+        auto it = m_knownProcesses.find(record.pid);
+        if (it != m_knownProcesses.end()) {
+            if (it->second.creationTime == record.creationTime) {
+                continue;
             }
-        } else {
+            
              
-            DWORD exitCode;
-            if (GetExitCodeProcess(hProcess, &exitCode) && exitCode != STILL_ACTIVE) {
-                terminated.push_back(pair.first);
-                
-                if (IsWatched(pair.second.name)) {
-                    if (m_callback) {
-                        m_callback(ProcessEvent::Terminated, pair.second);
-                    }
-                }
-            }
-            CloseHandle(hProcess);
+            RemoveKnownProcess(it);
         }
+        
+        ProcessInfo info;
+        info.pid = record.pid;
+        info.name = record.imageName;
+        info.creationTime = record.creationTime;
+        
+        AddKnownProcess(info);
     }
     
      
-    for (ProcessId pid : terminated) {
-        m_knownProcesses.erase(pid);
+    std::sort(m_livePids.begin(), m_livePids.end());
+    
+    for (auto it = m_knownProcesses.begin(); it != m_knownProcesses.end(); ) {
+        if (std::binary_search(m_livePids.begin(), m_livePids.end(), it->first)) {
+            ++it;
+        } else {
+            it = RemoveKnownProcess(it);
+        }
     }
 }
 
-bool ProcessMonitor::IsWatched(const std::wstring& processName) const {
-    std::wstring lowerName = utils::ToLower(processName);
-    return m_watchList.find(lowerName) != m_watchList.end();
+void ProcessMonitor::AddKnownProcess(const ProcessInfo& info) {
+    m_knownProcesses[info.pid] = info;
+    
+    if (IsWatched(info.name)) {
+        TrackProcess(info.pid);
+        
+        if (m_callback) {
+            m_callback(ProcessEvent::Started, info);
+        }
+    }
+}
+
+std::map<ProcessId, ProcessInfo>::iterator ProcessMonitor::RemoveKnownProcess(
+    std::map<ProcessId, ProcessInfo>::iterator it
+) {
+    UntrackProcess(it->first);
+    
+    if (IsWatched(it->second.name)) {
+        if (m_callback) {
+            m_callback(ProcessEvent::Terminated, it->second);
+        }
+    }
+    
+    return m_knownProcesses.erase(it);
+}
+
+void ProcessMonitor::TrackProcess(ProcessId pid) {
+    if (!m_running || m_waits.count(pid)) {
+        return;
+    }
+    
+    auto registration = std::make_unique<WaitRegistration>();
+    registration->monitor = this;
+    registration->pid = pid;
+    registration->process = OpenProcess(SYNCHRONIZE, FALSE, pid);
+    registration->wait = nullptr;
+    
+     
+    if (!registration->process) {
+        return;
+    }
+    
+    if (!RegisterWaitForSingleObject(&registration->wait, registration->process, &ProcessMonitor::OnProcessExited,
+            registration.get(), INFINITE, WT_EXECUTEONLYONCE)) {
+        LOG_WIN_ERROR(L"RegisterWaitForSingleObject");
+        CloseHandle(registration->process);
+        return;
+    }
+    
+    m_waits[pid] = std::move(registration);
+}
+
+void ProcessMonitor::UntrackProcess(ProcessId pid) {
+    auto it = m_waits.find(pid);
+    if (it == m_waits.end()) {
+        return;
+    }
+    
+     
+    UnregisterWaitEx(it->second->wait, INVALID_HANDLE_VALUE);
+    CloseHandle(it->second->process);
+    m_waits.erase(it);
+}
+
+void ProcessMonitor::RetrackWatchedProcesses() {
+    for (auto it = m_waits.begin(); it != m_waits.end(); ) {
+        auto known = m_knownProcesses.find(it->first);
+        ProcessId pid = it->first;
+        ++it;
+        
+        if (known == m_knownProcesses.end() || !IsWatched(known->second.name)) {
+            UntrackProcess(pid);
+        }
+    }
+    
+    for (const auto& pair : m_knownProcesses) {
+        if (IsWatched(pair.second.name)) {
+            TrackProcess(pair.first);
+        }
+    }
+}
+
+void CALLBACK ProcessMonitor::OnProcessExited(PVOID context, BOOLEAN timedOut) {
+    auto* registration = static_cast<WaitRegistration*>(context);
+    if (timedOut) {
+        return;
+    }
+    
+    ProcessEventNotification notification;
+    notification.event = ProcessEvent::Terminated;
+    notification.pid = registration->pid;
+    registration->monitor->OnSourceEvent(notification);
+}
+
+bool ProcessMonitor::IsWatched(std::wstring_view processName) const {
+    return m_matcher.Matches(processName);
+}
+
+void ProcessMonitor::RebuildMatcher() {
+    m_matcher.Build(std::vector<std::wstring>(m_watchList.begin(), m_watchList.end()));
 }
 
  
@@ -215,6 +462,7 @@ void AutoInjector::AddRule(
     rule.delay = delay;
     
     m_rules.push_back(rule);
+    RebuildMatcher();
     
     if (m_monitor->IsRunning()) {
         m_monitor->WatchProcess(processName);
@@ -235,6 +483,7 @@ void AutoInjector::RemoveRule(const std::wstring& processName) {
             }),
         m_rules.end()
     );
+    RebuildMatcher();
     
     m_monitor->UnwatchProcess(processName);
     
@@ -244,6 +493,7 @@ void AutoInjector::RemoveRule(const std::wstring& processName) {
 void AutoInjector::ClearRules() {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_rules.clear();
+    RebuildMatcher();
     m_monitor->ClearWatchList();
 }
 
@@ -259,21 +509,28 @@ void AutoInjector::OnProcessEvent(ProcessEvent event, const ProcessInfo& process
     
     std::lock_guard<std::mutex> lock(m_mutex);
     
-    std::wstring lowerName = utils::ToLower(process.name);
+    uint32_t index = m_matcher.FirstMatch(process.name);
+    if (index == WatchMatcher::NoMatch) {
+        return;
+    }
+    
+    const InjectionRule& rule = m_rules[index];
+    Log(LogLevel::Info, L"Auto-inject triggered for: " + process.name + 
+        L" (PID: " + std::to_wstring(process.pid) + L")");
     
+     
+    std::thread([this, process, rule]() {
+        PerformInjection(process, rule);
+    }).detach();
+}
+
+void AutoInjector::RebuildMatcher() {
+    std::vector<std::wstring> patterns;
+    patterns.reserve(m_rules.size());
     for (const auto& rule : m_rules) {
-        if (rule.processName == lowerName) {
-            Log(LogLevel::Info, L"Auto-inject triggered for: " + process.name + 
-                L" (PID: " + std::to_wstring(process.pid) + L")");
-            
-             
-            std::thread([this, process, rule]() {
-                PerformInjection(process, rule);
-            }).detach();
-            
-            break;
-        }
+        patterns.push_back(rule.processName);
     }
+    m_matcher.Build(patterns);
 }
 
 void AutoInjector::PerformInjection(const ProcessInfo& process, const InjectionRule& rule) {
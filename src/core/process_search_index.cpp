@@ -0,0 +1,141 @@
+#include "core/process_search_index.h"
+#include <algorithm>
+#include <cwctype>
+#include <utility>
+
+namespace xordll {
+
+wchar_t ProcessSearchIndex::Fold(wchar_t c) {
+    if (c < 0x80) {
+        return (c >= L'A' && c <= L'Z') ? static_cast<wchar_t>(c + (L'a' - L'A')) : c;
+    }
+    return static_cast<wchar_t>(std::towlower(c));
+}
+
+uint64_t ProcessSearchIndex::PackTrigram(wchar_t a, wchar_t b, wchar_t c) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(a) & 0x1FFFFF) << 42) |
+        (static_cast<uint64_t>(static_cast<uint32_t>(b) & 0x1FFFFF) << 21) |
+        (static_cast<uint64_t>(static_cast<uint32_t>(c) & 0x1FFFFF));
+}
+
+void ProcessSearchIndex::Clear() {
+    m_arena.clear();
+    m_offsets.assign(1, 0);
+    m_trigrams.clear();
+    m_postingOffsets.clear();
+    m_postings.clear();
+}
+
+void ProcessSearchIndex::Build(const std::vector<std::wstring>& names) {
+    Build(names, [](const std::wstring& name) -> const std::wstring& { return name; });
+}
+
+void ProcessSearchIndex::AppendName(const std::wstring& name) {
+    for (wchar_t c : name) {
+        m_arena.push_back(Fold(c));
+    }
+    m_offsets.push_back(static_cast<uint32_t>(m_arena.size()));
+}
+
+void ProcessSearchIndex::BuildTrigrams() {
+    std::vector<std::pair<uint64_t, uint32_t>> pairs;
+    pairs.reserve(m_arena.size());
+
+    for (uint32_t i = 0; i + 1 < m_offsets.size(); i++) {
+        uint32_t begin = m_offsets[i];
+        uint32_t end = m_offsets[i + 1];
+        for (uint32_t pos = begin; pos + 3 <= end; pos++) {
+            pairs.emplace_back(PackTrigram(m_arena[pos], m_arena[pos + 1], m_arena[pos + 2]), i);
+        }
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+
+    m_postings.reserve(pairs.size());
+    for (const auto& pair : pairs) {
+        if (m_trigrams.empty() || m_trigrams.back() != pair.first) {
+            m_trigrams.push_back(pair.first);
+            m_postingOffsets.push_back(static_cast<uint32_t>(m_postings.size()));
+        }
+        m_postings.push_back(pair.second);
+    }
+    m_postingOffsets.push_back(static_cast<uint32_t>(m_postings.size()));
+}
+
+std::wstring_view ProcessSearchIndex::Name(uint32_t index) const {
+    return std::wstring_view(m_arena.data() + m_offsets[index], m_offsets[index + 1] - m_offsets[index]);
+}
+
+bool ProcessSearchIndex::Contains(uint32_t index, std::wstring_view needle) const {
+    return Name(index).find(needle) != std::wstring_view::npos;
+}
+
+std::vector<uint32_t> ProcessSearchIndex::Find(std::wstring_view query) const {
+    std::vector<uint32_t> matches;
+    Find(query, matches);
+    return matches;
+}
+
+void ProcessSearchIndex::Find(std::wstring_view query, std::vector<uint32_t>& matches) const {
+    matches.clear();
+    uint32_t count = static_cast<uint32_t>(Size());
+
+    wchar_t stackBuffer[64];
+    std::wstring heapBuffer;
+    wchar_t* folded = stackBuffer;
+    if (query.size() > sizeof(stackBuffer) / sizeof(wchar_t)) {
+        heapBuffer.resize(query.size());
+        folded = &heapBuffer[0];
+    }
+    for (size_t i = 0; i < query.size(); i++) {
+        folded[i] = Fold(query[i]);
+    }
+    std::wstring_view needle(folded, query.size());
+
+    if (needle.empty()) {
+        matches.resize(count);
+        for (uint32_t i = 0; i < count; i++) {
+            matches[i] = i;
+        }
+        return;
+    }
+
+
+    if (needle.size() < 3) {
+        for (uint32_t i = 0; i < count; i++) {
+            if (Contains(i, needle)) {
+                matches.push_back(i);
+            }
+        }
+        return;
+    }
+
+
+    const uint32_t* best = nullptr;
+    const uint32_t* bestEnd = nullptr;
+    for (size_t pos = 0; pos + 3 <= needle.size(); pos++) {
+        uint64_t key = PackTrigram(needle[pos], needle[pos + 1], needle[pos + 2]);
+        auto it = std::lower_bound(m_trigrams.begin(), m_trigrams.end(), key);
+        if (it == m_trigrams.end() || *it != key) {
+            return;
+        }
+
+        size_t slot = static_cast<size_t>(it - m_trigrams.begin());
+        const uint32_t* begin = m_postings.data() + m_postingOffsets[slot];
+        const uint32_t* end = m_postings.data() + m_postingOffsets[slot + 1];
+        if (!best || end - begin < bestEnd - best) {
+            best = begin;
+            bestEnd = end;
+        }
+    }
+
+    for (const uint32_t* it = best; it != bestEnd; ++it) {
+        if (needle.size() == 3 || Contains(*it, needle)) {
+            matches.push_back(*it);
+        }
+    }
+}
+
+}
@@ -0,0 +1,134 @@
+#include "core/signature_verifier.h"
+#include <algorithm>
+
+namespace xordll {
+
+SignatureVerifier::SignatureVerifier(VerifyFunction verify, size_t workerCount)
+    : m_verify(std::move(verify))
+    , m_workerCount(workerCount ? workerCount : DefaultWorkerCount())
+    , m_stopping(false)
+{
+}
+
+SignatureVerifier::~SignatureVerifier() {
+    Shutdown();
+}
+
+std::shared_future<bool> SignatureVerifier::Submit(const std::wstring& path, Callback callback) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (m_stopping) {
+        lock.unlock();
+        bool isSigned = m_verify ? m_verify(path) : false;
+        if (callback) {
+            callback(path, isSigned ? SignatureStatus::Signed : SignatureStatus::Unsigned);
+        }
+        std::promise<bool> promise;
+        promise.set_value(isSigned);
+        return promise.get_future().share();
+    }
+
+    auto it = m_pending.find(path);
+    if (it != m_pending.end()) {
+        if (callback) {
+            it->second->callbacks.push_back(std::move(callback));
+        }
+        return it->second->future;
+    }
+
+    auto job = std::make_shared<Job>();
+    job->path = path;
+    job->future = job->promise.get_future().share();
+    if (callback) {
+        job->callbacks.push_back(std::move(callback));
+    }
+
+    m_pending[path] = job;
+    m_queue.push_back(job);
+
+    if (m_workers.size() < m_workerCount) {
+        m_workers.emplace_back(&SignatureVerifier::WorkerLoop, this);
+    }
+
+    lock.unlock();
+    m_condition.notify_one();
+    return job->future;
+}
+
+void SignatureVerifier::Shutdown() {
+    std::vector<std::thread> workers;
+    std::deque<std::shared_ptr<Job>> abandoned;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping) {
+            return;
+        }
+        m_stopping = true;
+        workers.swap(m_workers);
+        abandoned.swap(m_queue);
+        for (const auto& job : abandoned) {
+            m_pending.erase(job->path);
+        }
+    }
+
+    m_condition.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+
+    for (const auto& job : abandoned) {
+        for (const auto& callback : job->callbacks) {
+            callback(job->path, SignatureStatus::Unknown);
+        }
+        job->promise.set_value(false);
+    }
+}
+
+void SignatureVerifier::SetWorkerCount(size_t workerCount) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_workerCount = workerCount ? workerCount : DefaultWorkerCount();
+}
+
+size_t SignatureVerifier::PendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pending.size();
+}
+
+size_t SignatureVerifier::DefaultWorkerCount() {
+    size_t hardware = std::thread::hardware_concurrency();
+    return std::min<size_t>(std::max<size_t>(hardware / 2, 1), 4);
+}
+
+void SignatureVerifier::WorkerLoop() {
+    for (;;) {
+        std::shared_ptr<Job> job;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+            if (m_stopping) {
+                return;
+            }
+            job = m_queue.front();
+            m_queue.pop_front();
+        }
+
+        bool isSigned = m_verify ? m_verify(job->path) : false;
+
+        std::vector<Callback> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending.erase(job->path);
+            callbacks.swap(job->callbacks);
+        }
+
+        for (const auto& callback : callbacks) {
+            callback(job->path, isSigned ? SignatureStatus::Signed : SignatureStatus::Unsigned);
+        }
+        job->promise.set_value(isSigned);
+    }
+}
+
+}
@@ -0,0 +1,130 @@
+#include "core/system_process_parser.h"
+#include <cstring>
+
+namespace xordll {
+
+namespace {
+
+struct Layout {
+    size_t processSize;
+    size_t threadSize;
+    size_t createTime;
+    size_t imageNameLength;
+    size_t imageNameBuffer;
+    size_t uniqueProcessId;
+    size_t parentProcessId;
+    size_t threadUniqueThread;
+    size_t pointerSize;
+};
+
+
+constexpr Layout Layout64 = { 0x100, 0x50, 0x20, 0x38, 0x40, 0x50, 0x58, 0x30, 8 };
+constexpr Layout Layout32 = { 0xB8, 0x40, 0x20, 0x38, 0x3C, 0x44, 0x48, 0x24, 4 };
+
+template <typename T>
+T ReadAt(const uint8_t* data, size_t offset) {
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+uint64_t ReadPointer(const uint8_t* data, size_t offset, size_t pointerSize) {
+    return pointerSize == 8 ? ReadAt<uint64_t>(data, offset) : ReadAt<uint32_t>(data, offset);
+}
+
+bool ReadImageName(
+    const uint8_t* data,
+    size_t size,
+    uint64_t baseAddress,
+    const uint8_t* entry,
+    const Layout& layout,
+    std::wstring& name
+) {
+    uint16_t length = ReadAt<uint16_t>(entry, layout.imageNameLength);
+    uint64_t buffer = ReadPointer(entry, layout.imageNameBuffer, layout.pointerSize);
+
+    if (length == 0 || buffer == 0) {
+        name.clear();
+        return true;
+    }
+
+    if ((length & 1) || buffer < baseAddress || buffer - baseAddress > size ||
+        length > size - (buffer - baseAddress)) {
+        return false;
+    }
+
+    const uint8_t* chars = data + (buffer - baseAddress);
+    name.resize(length / sizeof(uint16_t));
+    for (size_t i = 0; i < name.size(); i++) {
+        name[i] = static_cast<wchar_t>(ReadAt<uint16_t>(chars, i * sizeof(uint16_t)));
+    }
+    return true;
+}
+
+}
+
+bool ParseSystemProcessInformation(
+    const uint8_t* data,
+    size_t size,
+    uint64_t baseAddress,
+    PointerWidth width,
+    bool includeThreads,
+    ProcessEnumeration& out
+) {
+    const Layout& layout = (width == PointerWidth::Bits64) ? Layout64 : Layout32;
+
+    size_t count = 0;
+    out.threadIds.clear();
+
+    size_t offset = 0;
+    for (;;) {
+        if (offset > size || size - offset < layout.processSize) {
+            return false;
+        }
+
+        const uint8_t* entry = data + offset;
+        uint32_t nextOffset = ReadAt<uint32_t>(entry, 0);
+        uint32_t threadCount = ReadAt<uint32_t>(entry, 4);
+
+
+        if (count == out.processes.size()) {
+            out.processes.emplace_back();
+        }
+        ProcessRecord& record = out.processes[count];
+        record.pid = static_cast<uint32_t>(ReadPointer(entry, layout.uniqueProcessId, layout.pointerSize));
+        record.parentPid = static_cast<uint32_t>(ReadPointer(entry, layout.parentProcessId, layout.pointerSize));
+        record.creationTime = ReadAt<uint64_t>(entry, layout.createTime);
+        record.firstThread = static_cast<uint32_t>(out.threadIds.size());
+        record.threadCount = 0;
+
+        if (!ReadImageName(data, size, baseAddress, entry, layout, record.imageName)) {
+            return false;
+        }
+
+        if (includeThreads) {
+            size_t available = (size - offset - layout.processSize) / layout.threadSize;
+            if (threadCount > available) {
+                return false;
+            }
+
+            const uint8_t* threads = entry + layout.processSize;
+            for (uint32_t i = 0; i < threadCount; i++) {
+                out.threadIds.push_back(static_cast<uint32_t>(
+                    ReadPointer(threads + i * layout.threadSize, layout.threadUniqueThread, layout.pointerSize)));
+            }
+            record.threadCount = threadCount;
+        }
+
+        count++;
+
+        if (nextOffset == 0) {
+            break;
+        }
+        offset += nextOffset;
+    }
+
+    out.processes.resize(count);
+    return true;
+}
+
+}
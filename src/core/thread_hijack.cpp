@@ -1,8 +1,9 @@
  
 
 #include "core/thread_hijack.h"
+#include "core/process_enumerator.h"
+#include "utils/logger.h"
 #include "utils/string_utils.h"
-#include <tlhelp32.h>
 
 namespace xordll {
 
@@ -18,7 +19,7 @@ InjectionResult ThreadHijacker::Inject(ProcessId processId, const std::wstring&
     result.success = false;
     result.method = InjectionMethod::ThreadHijack;
     
-    Log(LogLevel::Info, L"Starting thread hijack injection to PID: " + std::to_wstring(processId));
+    Log(LogLevel::Info, [&] { return L"Starting thread hijack injection to PID: " + std::to_wstring(processId); });
     
      
     HANDLE hProcess = OpenProcess(
@@ -156,8 +157,9 @@ InjectionResult ThreadHijacker::InjectWithThread(
         return result;
     }
     
-    Log(LogLevel::Debug, L"Shellcode written at: 0x" + 
-        utils::Utf8ToWide(std::to_string(reinterpret_cast<uintptr_t>(remoteShellcode))));
+    Log(LogLevel::Debug, [&] {
+        return L"Shellcode written at: 0x" + utils::Utf8ToWide(std::to_string(reinterpret_cast<uintptr_t>(remoteShellcode)));
+    });
     
      
     CONTEXT newCtx = originalCtx;
@@ -204,33 +206,32 @@ InjectionResult ThreadHijacker::InjectWithThread(
 }
 
 HANDLE ThreadHijacker::FindSuitableThread(ProcessId processId) {
-    HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
-    if (hSnapshot == INVALID_HANDLE_VALUE) {
+    ProcessEnumeration enumeration;
+    if (!ProcessEnumerator::EnumerateShared(enumeration, true)) {
         return nullptr;
     }
     
-    THREADENTRY32 te = { sizeof(te) };
-    HANDLE hThread = nullptr;
-    
-    if (Thread32First(hSnapshot, &te)) {
-        do {
-            if (te.th32OwnerProcessID == processId) {
-                 
-                hThread = OpenThread(
-                    THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | 
-                    THREAD_SET_CONTEXT | THREAD_QUERY_INFORMATION,
-                    FALSE, te.th32ThreadID);
-                
-                if (hThread) {
-                    Log(LogLevel::Debug, L"Found suitable thread: " + std::to_wstring(te.th32ThreadID));
-                    break;
-                }
+    for (const ProcessRecord& record : enumeration.processes) {
+        if (record.pid != processId) continue;
+        
+        for (uint32_t i = 0; i < record.threadCount; i++) {
+            DWORD threadId = enumeration.threadIds[record.firstThread + i];
+            
+             
+            HANDLE hThread = OpenThread(
+                THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | 
+                THREAD_SET_CONTEXT | THREAD_QUERY_INFORMATION,
+                FALSE, threadId);
+            
+            if (hThread) {
+                Log(LogLevel::Debug, [&] { return L"Found suitable thread: " + std::to_wstring(threadId); });
+                return hThread;
             }
-        } while (Thread32Next(hSnapshot, &te));
+        }
+        break;
     }
     
-    CloseHandle(hSnapshot);
-    return hThread;
+    return nullptr;
 }
 
 std::vector<BYTE> ThreadHijacker::GenerateShellcode(
@@ -356,9 +357,15 @@ std::vector<BYTE> ThreadHijacker::GenerateShellcode(
 void ThreadHijacker::Log(LogLevel level, const std::wstring& message) {
     if (m_logCallback) {
         m_logCallback(level, L"[ThreadHijack] " + message);
+    } else if (Logger::Instance().IsEnabled(level)) {
+        Logger::Instance().Log(level, L"[ThreadHijack] " + message);
     }
 }
 
+bool ThreadHijacker::IsLogEnabled(LogLevel level) const {
+    return IsLogLevelCompiled(level) && (m_logCallback || Logger::Instance().IsEnabled(level));
+}
+
  
  
  
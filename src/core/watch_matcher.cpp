@@ -0,0 +1,171 @@
+#include "core/watch_matcher.h"
+#include <cwctype>
+
+namespace xordll {
+
+wchar_t WatchMatcher::Fold(wchar_t c) {
+    if (c < 0x80) {
+        return (c >= L'A' && c <= L'Z') ? static_cast<wchar_t>(c + (L'a' - L'A')) : c;
+    }
+    return static_cast<wchar_t>(std::towlower(c));
+}
+
+uint64_t WatchMatcher::Hash(std::wstring_view name) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (wchar_t c : name) {
+        hash ^= static_cast<uint32_t>(Fold(c));
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+bool WatchMatcher::IsGlob(std::wstring_view pattern) {
+    return pattern.find_first_of(L"*?") != std::wstring_view::npos;
+}
+
+void WatchMatcher::Clear() {
+    m_arena.clear();
+    m_buckets.clear();
+    m_nextExact.clear();
+    m_globs.clear();
+}
+
+void WatchMatcher::Build(const std::vector<std::wstring>& patterns) {
+    Clear();
+
+    size_t exactCount = 0;
+    for (const std::wstring& pattern : patterns) {
+        if (!IsGlob(pattern)) exactCount++;
+    }
+
+    size_t capacity = 8;
+    while (capacity < exactCount * 2) {
+        capacity <<= 1;
+    }
+    m_buckets.assign(capacity, Bucket{ 0, 0, 0, NoMatch });
+    m_nextExact.assign(patterns.size(), NoMatch);
+
+     
+    std::vector<uint32_t> lastExact(capacity, NoMatch);
+
+    for (uint32_t rule = 0; rule < patterns.size(); rule++) {
+        const std::wstring& pattern = patterns[rule];
+        uint32_t offset = static_cast<uint32_t>(m_arena.size());
+
+        if (IsGlob(pattern)) {
+            Glob glob = { rule, offset, 0, 0 };
+            for (wchar_t c : pattern) {
+                 
+                if (c == L'*' && m_arena.size() > offset && m_arena.back() == L'*') {
+                    continue;
+                }
+                m_arena.push_back(Fold(c));
+                if (c != L'*') glob.minLength++;
+            }
+            glob.length = static_cast<uint32_t>(m_arena.size()) - offset;
+            m_globs.push_back(glob);
+            continue;
+        }
+
+        uint64_t hash = Hash(pattern);
+        size_t mask = capacity - 1;
+        for (size_t slot = static_cast<size_t>(hash) & mask; ; slot = (slot + 1) & mask) {
+            Bucket& bucket = m_buckets[slot];
+
+            if (bucket.firstRule == NoMatch) {
+                for (wchar_t c : pattern) {
+                    m_arena.push_back(Fold(c));
+                }
+                bucket = Bucket{ hash, offset, static_cast<uint32_t>(pattern.size()), rule };
+                lastExact[slot] = rule;
+                break;
+            }
+
+            if (bucket.hash == hash && EqualsFolded(bucket, pattern)) {
+                m_nextExact[lastExact[slot]] = rule;
+                lastExact[slot] = rule;
+                break;
+            }
+        }
+    }
+}
+
+bool WatchMatcher::EqualsFolded(const Bucket& bucket, std::wstring_view name) const {
+    if (bucket.length != name.size()) {
+        return false;
+    }
+
+    const wchar_t* key = m_arena.data() + bucket.offset;
+    for (size_t i = 0; i < name.size(); i++) {
+        if (key[i] != Fold(name[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t WatchMatcher::FindExact(std::wstring_view name) const {
+    if (m_buckets.empty()) {
+        return NoMatch;
+    }
+
+    uint64_t hash = Hash(name);
+    size_t mask = m_buckets.size() - 1;
+    for (size_t slot = static_cast<size_t>(hash) & mask; ; slot = (slot + 1) & mask) {
+        const Bucket& bucket = m_buckets[slot];
+        if (bucket.firstRule == NoMatch) {
+            return NoMatch;
+        }
+        if (bucket.hash == hash && EqualsFolded(bucket, name)) {
+            return bucket.firstRule;
+        }
+    }
+}
+
+bool WatchMatcher::MatchGlob(const Glob& glob, std::wstring_view name) const {
+    if (name.size() < glob.minLength) {
+        return false;
+    }
+
+    const wchar_t* pattern = m_arena.data() + glob.offset;
+    size_t p = 0;
+    size_t n = 0;
+    size_t star = SIZE_MAX;
+    size_t resume = 0;
+
+     
+    while (n < name.size()) {
+        if (p < glob.length && pattern[p] != L'*' && (pattern[p] == L'?' || pattern[p] == Fold(name[n]))) {
+            p++;
+            n++;
+        } else if (p < glob.length && pattern[p] == L'*') {
+            star = p++;
+            resume = n;
+        } else if (star != SIZE_MAX) {
+            p = star + 1;
+            n = ++resume;
+        } else {
+            return false;
+        }
+    }
+
+    while (p < glob.length && pattern[p] == L'*') {
+        p++;
+    }
+    return p == glob.length;
+}
+
+uint32_t WatchMatcher::FirstMatch(std::wstring_view name) const {
+    uint32_t first = FindExact(name);
+
+    for (const Glob& glob : m_globs) {
+        if (glob.rule >= first) break;
+        if (MatchGlob(glob, name)) {
+            return glob.rule;
+        }
+    }
+
+    return first;
+}
+
+}
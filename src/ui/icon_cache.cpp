@@ -0,0 +1,112 @@
+#include "ui/icon_cache.h"
+#include <cwctype>
+
+namespace xordll {
+namespace ui {
+
+IconCache::IconCache(LoadFunction load, int firstSlot)
+    : m_load(std::move(load))
+    , m_firstSlot(firstSlot)
+    , m_nextSlot(firstSlot)
+{
+}
+
+std::wstring IconCache::MakeKey(const std::wstring& path) {
+    std::wstring key = path;
+    for (auto& c : key) {
+        c = static_cast<wchar_t>(std::towlower(c));
+    }
+    return key;
+}
+
+int IconCache::AllocateSlot() {
+    if (!m_freeSlots.empty()) {
+        int slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        return slot;
+    }
+    return m_nextSlot++;
+}
+
+void IconCache::Update(const std::vector<std::wstring>& paths) {
+    std::vector<std::wstring> live;
+    std::vector<std::wstring> added;
+    live.reserve(paths.size());
+
+    for (const auto& path : paths) {
+        if (path.empty()) {
+            continue;
+        }
+
+        auto it = m_entries.find(MakeKey(path));
+        if (it != m_entries.end()) {
+            it->second.refCount++;
+        } else {
+            added.push_back(path);
+        }
+        live.push_back(path);
+    }
+
+
+    for (const auto& path : m_live) {
+        Release(path);
+    }
+
+    for (const auto& path : added) {
+        Acquire(path);
+    }
+
+    m_live.swap(live);
+}
+
+int IconCache::Acquire(const std::wstring& path) {
+    std::wstring key = MakeKey(path);
+
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        it->second.refCount++;
+        return it->second.slot;
+    }
+
+    int slot = AllocateSlot();
+    if (!m_load || !m_load(path, slot)) {
+        m_freeSlots.push_back(slot);
+        slot = NoIcon;
+    }
+
+    m_entries.emplace(std::move(key), Entry{ slot, 1 });
+    return slot;
+}
+
+void IconCache::Release(const std::wstring& path) {
+    auto it = m_entries.find(MakeKey(path));
+    if (it == m_entries.end()) {
+        return;
+    }
+
+    if (--it->second.refCount == 0) {
+        if (it->second.slot != NoIcon) {
+            m_freeSlots.push_back(it->second.slot);
+        }
+        m_entries.erase(it);
+    }
+}
+
+int IconCache::IndexOf(const std::wstring& path) const {
+    if (path.empty()) {
+        return NoIcon;
+    }
+
+    auto it = m_entries.find(MakeKey(path));
+    return it != m_entries.end() ? it->second.slot : NoIcon;
+}
+
+void IconCache::Clear() {
+    m_entries.clear();
+    m_live.clear();
+    m_freeSlots.clear();
+    m_nextSlot = m_firstSlot;
+}
+
+}
+}
@@ -70,8 +70,13 @@ MainWindow::MainWindow()
     , m_bgHeight(0)
     , m_alwaysOnTop(false)
     , m_minimizedToTray(false)
+    , m_logStatusPosted(false)
 {
     m_processManager = std::make_unique<ProcessManager>();
+    m_snapshot = m_processManager->GetSnapshot();
+    m_refreshWorker = std::make_unique<ui::RefreshWorker>(
+        [this]() { return m_processManager->RefreshProcessList(); },
+        [this](bool success) { PostMessageW(m_hwnd, WM_PROCESSES_REFRESHED, success, 0); });
     m_injectionCore = std::make_unique<InjectionCore>();
     m_hotkeyManager = std::make_unique<ui::HotkeyManager>();
     m_trayIcon = std::make_unique<ui::TrayIcon>();
@@ -152,7 +157,27 @@ void MainWindow::SetColorScheme(const ColorScheme& scheme)
 
 void MainWindow::AddLogEntry(LogLevel level, const std::wstring& message)
 {
+    if (GetWindowThreadProcessId(m_hwnd, nullptr) == GetCurrentThreadId()) {
+        SetStatusText(message, 0);
+        return;
+    }
+    
      
+    std::lock_guard<std::mutex> lock(m_logStatusMutex);
+    m_logStatus = message;
+    if (!m_logStatusPosted) {
+        m_logStatusPosted = PostMessageW(m_hwnd, WM_LOG_STATUS, 0, 0) != FALSE;
+    }
+}
+
+void MainWindow::OnLogStatus()
+{
+    std::wstring message;
+    {
+        std::lock_guard<std::mutex> lock(m_logStatusMutex);
+        message.swap(m_logStatus);
+        m_logStatusPosted = false;
+    }
     SetStatusText(message, 0);
 }
 
@@ -235,6 +260,14 @@ LRESULT MainWindow::HandleMessage(UINT msg, WPARAM wParam, LPARAM lParam)
             OnTrayIcon(lParam);
             return 0;
             
+        case WM_PROCESSES_REFRESHED:
+            OnProcessesRefreshed();
+            return 0;
+            
+        case WM_LOG_STATUS:
+            OnLogStatus();
+            return 0;
+            
          
             
         case WM_ERASEBKGND:
@@ -330,14 +363,27 @@ void MainWindow::CreateControls()
     
      
     m_hwndProcessList = CreateWindowExW(WS_EX_CLIENTEDGE, WC_LISTVIEW, L"",
-        WS_CHILD | WS_VISIBLE | LVS_REPORT | LVS_SINGLESEL | LVS_SHOWSELALWAYS | LVS_NOCOLUMNHEADER,
+        WS_CHILD | WS_VISIBLE | LVS_REPORT | LVS_SINGLESEL | LVS_SHOWSELALWAYS | LVS_NOCOLUMNHEADER | LVS_OWNERDATA,
         MARGIN, y, leftWidth, listHeight,
         m_hwnd, reinterpret_cast<HMENU>(ID_PROCESS_LIST), m_hInstance, nullptr);
     
     m_hImageList = ImageList_Create(16, 16, ILC_COLOR32 | ILC_MASK, 50, 20);
+    ImageList_AddIcon(m_hImageList, LoadIcon(nullptr, IDI_APPLICATION));
     ListView_SetImageList(m_hwndProcessList, m_hImageList, LVSIL_SMALL);
     ListView_SetExtendedListViewStyle(m_hwndProcessList, LVS_EX_FULLROWSELECT | LVS_EX_DOUBLEBUFFER);
     
+    m_iconCache = std::make_unique<ui::IconCache>([this](const std::wstring& path, int slot) {
+        HICON hIcon = ProcessManager::GetProcessIcon(path);
+        if (!hIcon) {
+            return false;
+        }
+        
+        int replace = slot < ImageList_GetImageCount(m_hImageList) ? slot : -1;
+        int index = ImageList_ReplaceIcon(m_hImageList, replace, hIcon);
+        DestroyIcon(hIcon);
+        return index == slot;
+    }, DEFAULT_ICON_INDEX + 1);
+    
     LVCOLUMN lvc = { 0 };
     lvc.mask = LVCF_WIDTH;
     lvc.cx = leftWidth - 20;
@@ -672,8 +718,11 @@ void MainWindow::OnCreate()
 void MainWindow::OnDestroy()
 {
     KillTimer(m_hwnd, ID_TIMER_REFRESH);
+    Logger::Instance().SetUICallback(nullptr);
+    m_refreshWorker->Stop();
     m_hotkeyManager->Shutdown();
     m_trayIcon->Remove();
+    m_iconCache.reset();
     if (m_hImageList) {
         ImageList_Destroy(m_hImageList);
         m_hImageList = nullptr;
@@ -807,7 +856,7 @@ void MainWindow::OnNotify(WPARAM wParam, LPARAM lParam)
                 if ((nmlistview->uNewState & LVIS_SELECTED) && 
                     !(nmlistview->uOldState & LVIS_SELECTED)) {
                      
-                    ProcessInfo* proc = GetSelectedProcess();
+                    const ProcessInfo* proc = GetSelectedProcess();
                     if (proc) {
                         m_selectedPid = proc->pid;
                         std::wstring info = proc->name + L" (PID: " + std::to_wstring(proc->pid) + L")";
@@ -817,6 +866,9 @@ void MainWindow::OnNotify(WPARAM wParam, LPARAM lParam)
                 }
                 break;
             }
+            case LVN_GETDISPINFOW:
+                OnGetProcessDispInfo(reinterpret_cast<NMLVDISPINFOW*>(lParam));
+                break;
             case NM_CLICK: {
                 NMITEMACTIVATE* nmia = reinterpret_cast<NMITEMACTIVATE*>(lParam);
                 if (nmia->iItem >= 0) {
@@ -873,21 +925,33 @@ void MainWindow::OnDropFiles(HDROP hDrop)
 
 void MainWindow::RefreshProcessList()
 {
-    SetStatusText(L"Refreshing process list...", 0);
+    if (m_refreshWorker->Request()) {
+        SetStatusText(L"Refreshing process list...", 0);
+    }
+}
+
+void MainWindow::OnProcessesRefreshed()
+{
+    m_snapshot = m_processManager->GetSnapshot();
     
-    m_processManager->RefreshProcessList();
+    std::vector<std::wstring> paths;
+    paths.reserve(m_snapshot->processes.size());
+    for (const auto& proc : m_snapshot->processes) {
+        paths.push_back(proc.path);
+    }
+    m_iconCache->Update(paths);
     
     wchar_t filter[256];
     GetWindowTextW(m_hwndProcessSearch, filter, 256);
     FilterProcessList(filter);
     
-    SetStatusText(L"Ready - " + std::to_wstring(m_filteredProcesses.size()) + L" processes", 0);
+    SetStatusText(L"Ready - " + std::to_wstring(m_filteredIndices.size()) + L" processes", 0);
 }
 
 
 void MainWindow::PerformInjection()
 {
-    ProcessInfo* proc = GetSelectedProcess();
+    const ProcessInfo* proc = GetSelectedProcess();
     if (!proc) {
         MessageBoxW(m_hwnd, L"Please select a target process.", L"No Process Selected", MB_ICONWARNING);
         return;
@@ -974,66 +1038,65 @@ void MainWindow::OpenGitHub()
 
 void MainWindow::PopulateProcessList()
 {
-    ListView_DeleteAllItems(m_hwndProcessList);
-    ImageList_RemoveAll(m_hImageList);
-    
-    HICON hDefaultIcon = LoadIcon(nullptr, IDI_APPLICATION);
-    int defaultIconIndex = ImageList_AddIcon(m_hImageList, hDefaultIcon);
-    
-    LVITEM lvi = { 0 };
-    lvi.mask = LVIF_TEXT | LVIF_IMAGE | LVIF_PARAM;
-    
+    int previousIndex = ListView_GetNextItem(m_hwndProcessList, -1, LVNI_SELECTED);
     int selectIndex = -1;
     
-    for (size_t i = 0; i < m_filteredProcesses.size(); ++i) {
-        auto& proc = m_filteredProcesses[i];
-        
-         
-        if (proc.pid == m_selectedPid) {
+     
+    for (size_t i = 0; i < m_filteredIndices.size(); ++i) {
+        if (m_snapshot->processes[m_filteredIndices[i]].pid == m_selectedPid) {
             selectIndex = static_cast<int>(i);
+            break;
         }
-        
-        int iconIndex = defaultIconIndex;
-        if (!proc.path.empty()) {
-            HICON hIcon = ProcessManager::GetProcessIcon(proc.path);
-            if (hIcon) {
-                iconIndex = ImageList_AddIcon(m_hImageList, hIcon);
-                DestroyIcon(hIcon);
-            }
-        }
-        
-        std::wstring displayText = proc.name + L" (" + std::to_wstring(proc.pid) + L")";
-        if (proc.is64Bit) displayText += L" [64]";
-        
-        lvi.iItem = static_cast<int>(i);
-        lvi.iSubItem = 0;
-        lvi.iImage = iconIndex;
-        lvi.lParam = static_cast<LPARAM>(i);
-        lvi.pszText = const_cast<LPWSTR>(displayText.c_str());
-        ListView_InsertItem(m_hwndProcessList, &lvi);
     }
     
-     
+    ListView_SetItemState(m_hwndProcessList, -1, 0, LVIS_SELECTED | LVIS_FOCUSED);
+    ListView_SetItemCountEx(m_hwndProcessList, static_cast<int>(m_filteredIndices.size()), LVSICF_NOSCROLL);
+    
     if (selectIndex >= 0) {
         ListView_SetItemState(m_hwndProcessList, selectIndex, 
             LVIS_SELECTED | LVIS_FOCUSED, LVIS_SELECTED | LVIS_FOCUSED);
-        ListView_EnsureVisible(m_hwndProcessList, selectIndex, FALSE);
+        if (selectIndex != previousIndex) {
+            ListView_EnsureVisible(m_hwndProcessList, selectIndex, FALSE);
+        }
+    }
+    
+    InvalidateRect(m_hwndProcessList, nullptr, FALSE);
+}
+
+void MainWindow::OnGetProcessDispInfo(NMLVDISPINFOW* dispInfo)
+{
+    LVITEMW& item = dispInfo->item;
+    if (item.iItem < 0 || item.iItem >= static_cast<int>(m_filteredIndices.size())) {
+        return;
+    }
+    
+    const ProcessInfo& proc = m_snapshot->processes[m_filteredIndices[item.iItem]];
+    
+    if (item.mask & LVIF_TEXT) {
+        std::wstring displayText = proc.name + L" (" + std::to_wstring(proc.pid) + L")";
+        if (proc.is64Bit) displayText += L" [64]";
+        lstrcpynW(item.pszText, displayText.c_str(), item.cchTextMax);
+    }
+    
+    if (item.mask & LVIF_IMAGE) {
+        int iconIndex = m_iconCache->IndexOf(proc.path);
+        item.iImage = iconIndex == ui::IconCache::NoIcon ? DEFAULT_ICON_INDEX : iconIndex;
     }
 }
 
 void MainWindow::FilterProcessList(const std::wstring& filter)
 {
-    m_filteredProcesses = m_processManager->FilterByName(filter);
+    m_filteredIndices = m_snapshot->FilterByName(filter);
     PopulateProcessList();
 }
 
-ProcessInfo* MainWindow::GetSelectedProcess()
+const ProcessInfo* MainWindow::GetSelectedProcess()
 {
     int sel = ListView_GetNextItem(m_hwndProcessList, -1, LVNI_SELECTED);
-    if (sel < 0 || sel >= static_cast<int>(m_filteredProcesses.size())) {
+    if (sel < 0 || sel >= static_cast<int>(m_filteredIndices.size())) {
         return nullptr;
     }
-    return &m_filteredProcesses[sel];
+    return &m_snapshot->processes[m_filteredIndices[sel]];
 }
 
 InjectionMethod MainWindow::GetSelectedMethod()
@@ -0,0 +1,81 @@
+#include "ui/refresh_worker.h"
+
+namespace xordll {
+namespace ui {
+
+RefreshWorker::RefreshWorker(RefreshFunction refresh, CompletionFunction onComplete)
+    : m_refresh(std::move(refresh))
+    , m_onComplete(std::move(onComplete))
+    , m_requested(false)
+    , m_running(false)
+    , m_stopping(false)
+    , m_completed(0)
+{
+    m_thread = std::thread(&RefreshWorker::WorkerLoop, this);
+}
+
+RefreshWorker::~RefreshWorker() {
+    Stop();
+}
+
+bool RefreshWorker::Request() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping || m_requested) {
+            return false;
+        }
+        m_requested = true;
+    }
+
+    m_condition.notify_one();
+    return true;
+}
+
+void RefreshWorker::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_requested = false;
+    }
+
+    m_condition.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+bool RefreshWorker::IsBusy() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_running || m_requested;
+}
+
+uint64_t RefreshWorker::CompletedCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_completed;
+}
+
+void RefreshWorker::WorkerLoop() {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_stopping || m_requested; });
+            if (m_stopping) {
+                return;
+            }
+            m_requested = false;
+            m_running = true;
+        }
+
+        bool success = m_refresh ? m_refresh() : false;
+        if (m_onComplete) {
+            m_onComplete(success);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+        m_completed++;
+    }
+}
+
+}
+}
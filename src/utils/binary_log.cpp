@@ -0,0 +1,354 @@
+#include "utils/binary_log.h"
+#include <algorithm>
+#include <cstring>
+
+namespace xordll {
+namespace utils {
+
+namespace {
+
+constexpr uint8_t LevelMask = 0x07;
+constexpr uint8_t ResetFlag = 0x08;
+constexpr uint8_t ThreadShift = 4;
+constexpr size_t ThreadEscape = 15;
+constexpr size_t DistanceBits = 4;
+static_assert(BinaryLog::RecentPayloads == 1 << DistanceBits, "distance must fit its bits");
+constexpr size_t MaxPayloadSize = BinaryLog::MaxRecordSize - 256;
+
+template <typename T>
+void AppendValue(std::string& out, T value) {
+    char bytes[sizeof(T)];
+    for (size_t i = 0; i < sizeof(T); i++) {
+        bytes[i] = static_cast<char>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF);
+    }
+    out.append(bytes, sizeof(T));
+}
+
+template <typename T>
+T ReadValue(const char* data) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(T); i++) {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(data[i])) << (8 * i);
+    }
+    return static_cast<T>(value);
+}
+
+void AppendVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+enum class VarintResult {
+    Ok,
+    Truncated,
+    Overlong
+};
+
+VarintResult ReadVarint(const char*& data, const char* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (data == end) {
+            return VarintResult::Truncated;
+        }
+        uint8_t byte = static_cast<uint8_t>(*data++);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return VarintResult::Ok;
+        }
+    }
+    return VarintResult::Overlong;
+}
+
+bool ReadBodyVarint(const char*& data, const char* end, uint64_t& value) {
+    return ReadVarint(data, end, value) == VarintResult::Ok;
+}
+
+uint64_t ZigZag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t UnZigZag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+size_t SharedPrefix(const std::string& previous, const std::string& payload) {
+    size_t limit = std::min(previous.size(), payload.size());
+    size_t shared = 0;
+    while (shared < limit && previous[shared] == payload[shared]) {
+        shared++;
+    }
+    return shared;
+}
+
+}
+
+void BinaryLog::AppendFileHeader(std::string& out) {
+    out.append(Magic, sizeof(Magic));
+    AppendValue<uint16_t>(out, Version);
+    AppendValue<uint16_t>(out, 0);
+}
+
+bool BinaryLog::HasFileHeader(const char* data, size_t size) {
+    return size >= FileHeaderSize &&
+        std::memcmp(data, Magic, sizeof(Magic)) == 0 &&
+        ReadValue<uint16_t>(data + sizeof(Magic)) == Version;
+}
+
+void BinaryLog::Encoder::Reset() {
+    m_resetPending = true;
+}
+
+void BinaryLog::Encoder::Append(
+    std::string& out,
+    uint64_t timestampNs,
+    uint32_t threadId,
+    uint8_t level,
+    std::wstring_view message
+) {
+    std::wstring_view tag;
+    std::wstring_view body;
+    SplitSourceTag(message, tag, body);
+
+    m_tag.clear();
+    AppendUtf8(m_tag, tag);
+    m_payload.clear();
+    AppendUtf8(m_payload, body);
+    if (m_payload.size() > MaxPayloadSize) {
+        m_payload.resize(MaxPayloadSize);
+    }
+
+    size_t threadSlot = 0;
+    while (threadSlot < m_threads.size() && m_threads[threadSlot] != threadId) {
+        threadSlot++;
+    }
+    size_t tagSlot = 0;
+    while (!m_tag.empty() && tagSlot < m_tags.size() && m_tags[tagSlot] != m_tag) {
+        tagSlot++;
+    }
+
+    bool threadFull = threadSlot == m_threads.size() && m_threads.size() >= MaxDictionarySize;
+    bool tagFull = !m_tag.empty() && tagSlot == m_tags.size() && m_tags.size() >= MaxDictionarySize;
+    bool reset = m_resetPending || threadFull || tagFull;
+    if (reset) {
+        m_threads.clear();
+        m_tags.clear();
+        for (auto& recent : m_recent) {
+            recent.clear();
+        }
+        m_recentNext = 0;
+        threadSlot = 0;
+        tagSlot = 0;
+        m_resetPending = false;
+    }
+
+    uint8_t flags = static_cast<uint8_t>((level & LevelMask) | (reset ? ResetFlag : 0) |
+        (std::min(threadSlot, ThreadEscape) << ThreadShift));
+
+    m_body.clear();
+    m_body.push_back(static_cast<char>(flags));
+    if (threadSlot >= ThreadEscape) {
+        AppendVarint(m_body, threadSlot);
+    }
+    if (threadSlot == m_threads.size()) {
+        AppendVarint(m_body, threadId);
+        m_threads.push_back(threadId);
+    }
+
+    AppendVarint(m_body, reset ? timestampNs : ZigZag(static_cast<int64_t>(timestampNs - m_lastTimestamp)));
+    m_lastTimestamp = timestampNs;
+
+    if (m_tag.empty()) {
+        AppendVarint(m_body, 0);
+    } else {
+        AppendVarint(m_body, tagSlot + 1);
+        if (tagSlot == m_tags.size()) {
+            m_body.push_back(static_cast<char>(m_tag.size()));
+            m_body += m_tag;
+            m_tags.push_back(m_tag);
+        }
+    }
+
+    size_t shared = 0;
+    size_t distance = 0;
+    for (size_t back = 0; back < RecentPayloads; back++) {
+        size_t length = SharedPrefix(m_recent[(m_recentNext + RecentPayloads - 1 - back) % RecentPayloads], m_payload);
+        if (length > shared) {
+            shared = length;
+            distance = back;
+        }
+    }
+    AppendVarint(m_body, (shared << DistanceBits) | distance);
+    m_body.append(m_payload, shared, std::string::npos);
+    m_recent[m_recentNext].assign(m_payload, 0, std::min(m_payload.size(), MaxSharedPrefix));
+    m_recentNext = (m_recentNext + 1) % RecentPayloads;
+
+    AppendVarint(out, m_body.size());
+    out += m_body;
+}
+
+void BinaryLog::Decoder::Reset() {
+    m_threads.clear();
+    m_tags.clear();
+    for (auto& recent : m_recent) {
+        recent.clear();
+    }
+    m_recentNext = 0;
+    m_lastTimestamp = 0;
+}
+
+BinaryLog::Status BinaryLog::Decoder::Decode(
+    const char* data,
+    size_t size,
+    BinaryLogRecord& record,
+    size_t& consumed
+) {
+    const char* cursor = data;
+    const char* end = data + size;
+
+    uint64_t length = 0;
+    VarintResult prefix = ReadVarint(cursor, end, length);
+    if (prefix == VarintResult::Truncated) {
+        return cursor - data < 5 ? Status::Incomplete : Status::Corrupt;
+    }
+    if (prefix == VarintResult::Overlong || length == 0 || length > MaxRecordSize) {
+        return Status::Corrupt;
+    }
+    if (static_cast<uint64_t>(end - cursor) < length) {
+        return Status::Incomplete;
+    }
+
+    end = cursor + length;
+    uint8_t flags = static_cast<uint8_t>(*cursor++);
+    bool reset = (flags & ResetFlag) != 0;
+    size_t threadCount = reset ? 0 : m_threads.size();
+    size_t tagCount = reset ? 0 : m_tags.size();
+
+    uint64_t threadSlot = flags >> ThreadShift;
+    if (threadSlot == ThreadEscape && !ReadBodyVarint(cursor, end, threadSlot)) {
+        return Status::Corrupt;
+    }
+    uint64_t newThreadId = 0;
+    if (threadSlot > threadCount) {
+        return Status::Corrupt;
+    }
+    if (threadSlot == threadCount &&
+        (threadCount >= MaxDictionarySize || !ReadBodyVarint(cursor, end, newThreadId) || newThreadId > UINT32_MAX)) {
+        return Status::Corrupt;
+    }
+
+    uint64_t stamp = 0;
+    uint64_t tagSlot = 0;
+    uint64_t shared = 0;
+    if (!ReadBodyVarint(cursor, end, stamp) || !ReadBodyVarint(cursor, end, tagSlot) || tagSlot > tagCount + 1) {
+        return Status::Corrupt;
+    }
+
+    std::string_view newTag;
+    if (tagSlot == tagCount + 1) {
+        if (cursor == end || tagCount >= MaxDictionarySize) {
+            return Status::Corrupt;
+        }
+        size_t tagLength = static_cast<uint8_t>(*cursor++);
+        if (tagLength == 0 || static_cast<size_t>(end - cursor) < tagLength) {
+            return Status::Corrupt;
+        }
+        newTag = std::string_view(cursor, tagLength);
+        cursor += tagLength;
+    }
+
+    if (!ReadBodyVarint(cursor, end, shared)) {
+        return Status::Corrupt;
+    }
+    size_t distance = static_cast<size_t>(shared & (RecentPayloads - 1));
+    shared >>= DistanceBits;
+    const std::string& previous = m_recent[(m_recentNext + RecentPayloads - 1 - distance) % RecentPayloads];
+    if (shared > (reset ? 0 : previous.size())) {
+        return Status::Corrupt;
+    }
+
+    m_payload.assign(previous, 0, static_cast<size_t>(shared));
+    m_payload.append(cursor, end);
+
+    if (reset) {
+        Reset();
+    }
+    if (threadSlot == m_threads.size()) {
+        m_threads.push_back(static_cast<uint32_t>(newThreadId));
+    }
+    if (!newTag.empty()) {
+        m_tags.emplace_back(newTag);
+    }
+
+    m_lastTimestamp = reset ? stamp : m_lastTimestamp + static_cast<uint64_t>(UnZigZag(stamp));
+    m_recent[m_recentNext].assign(m_payload, 0, std::min(m_payload.size(), MaxSharedPrefix));
+    m_recentNext = (m_recentNext + 1) % RecentPayloads;
+
+    record.timestampNs = m_lastTimestamp;
+    record.threadId = m_threads[threadSlot];
+    record.level = static_cast<uint8_t>(flags & LevelMask);
+    record.tag = tagSlot ? std::string_view(m_tags[tagSlot - 1]) : std::string_view();
+    record.payload = m_payload;
+    consumed = static_cast<size_t>(end - data);
+    return Status::Ok;
+}
+
+void BinaryLog::SplitSourceTag(std::wstring_view message, std::wstring_view& tag, std::wstring_view& body) {
+    tag = std::wstring_view();
+    body = message;
+
+    if (message.size() < 3 || message[0] != L'[') {
+        return;
+    }
+
+    size_t close = message.find(L']', 1);
+    if (close == std::wstring_view::npos || close == 1 || close - 1 > MaxTagLength) {
+        return;
+    }
+
+    tag = message.substr(1, close - 1);
+    body = message.substr(close + 1);
+    if (!body.empty() && body[0] == L' ') {
+        body.remove_prefix(1);
+    }
+}
+
+void BinaryLog::AppendUtf8(std::string& out, std::wstring_view text) {
+    for (size_t i = 0; i < text.size(); i++) {
+        uint32_t c = static_cast<uint32_t>(text[i]);
+
+         
+        if (c >= 0xD800 && c <= 0xDBFF && i + 1 < text.size()) {
+            uint32_t low = static_cast<uint32_t>(text[i + 1]);
+            if (low >= 0xDC00 && low <= 0xDFFF) {
+                c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+                i++;
+            }
+        }
+
+        if (c >= 0xD800 && c <= 0xDFFF) {
+            c = 0xFFFD;
+        }
+
+        if (c < 0x80) {
+            out.push_back(static_cast<char>(c));
+        } else if (c < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (c >> 6)));
+            out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        } else if (c < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (c >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (c >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((c >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        }
+    }
+}
+
+}
+}
@@ -0,0 +1,211 @@
+#include "utils/gzip.h"
+#include <algorithm>
+#include <array>
+
+namespace xordll {
+namespace utils {
+
+namespace {
+
+constexpr size_t WindowSize = 32768;
+constexpr size_t WindowMask = WindowSize - 1;
+constexpr size_t HashSize = 1 << 15;
+constexpr size_t MinMatch = 3;
+constexpr size_t MaxMatch = 258;
+constexpr size_t MaxChain = 64;
+constexpr uint32_t EndOfBlock = 256;
+
+constexpr uint16_t LengthBase[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+constexpr uint8_t LengthExtra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+constexpr uint16_t DistanceBase[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+constexpr uint8_t DistanceExtra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+const std::array<uint32_t, 256>& CrcTable() {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> result{};
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            result[i] = c;
+        }
+        return result;
+    }();
+    return table;
+}
+
+
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : m_out(out), m_bits(0), m_count(0) {}
+
+    void Write(uint32_t value, int count) {
+        m_bits |= static_cast<uint64_t>(value) << m_count;
+        m_count += count;
+        while (m_count >= 8) {
+            m_out.push_back(static_cast<uint8_t>(m_bits));
+            m_bits >>= 8;
+            m_count -= 8;
+        }
+    }
+
+    void WriteCode(uint32_t code, int length) {
+        uint32_t reversed = 0;
+        for (int i = 0; i < length; i++) {
+            reversed = (reversed << 1) | ((code >> i) & 1);
+        }
+        Write(reversed, length);
+    }
+
+    void Finish() {
+        if (m_count > 0) {
+            m_out.push_back(static_cast<uint8_t>(m_bits));
+        }
+        m_bits = 0;
+        m_count = 0;
+    }
+
+private:
+    std::vector<uint8_t>& m_out;
+    uint64_t m_bits;
+    int m_count;
+};
+
+
+void WriteSymbol(BitWriter& writer, uint32_t symbol) {
+    if (symbol < 144) {
+        writer.WriteCode(0x30 + symbol, 8);
+    } else if (symbol < 256) {
+        writer.WriteCode(0x190 + symbol - 144, 9);
+    } else if (symbol < 280) {
+        writer.WriteCode(symbol - 256, 7);
+    } else {
+        writer.WriteCode(0xC0 + symbol - 280, 8);
+    }
+}
+
+void WriteMatch(BitWriter& writer, size_t length, size_t distance) {
+    size_t lengthCode = std::upper_bound(std::begin(LengthBase), std::end(LengthBase), length) - std::begin(LengthBase) - 1;
+    WriteSymbol(writer, static_cast<uint32_t>(257 + lengthCode));
+    writer.Write(static_cast<uint32_t>(length - LengthBase[lengthCode]), LengthExtra[lengthCode]);
+
+    size_t distanceCode = std::upper_bound(std::begin(DistanceBase), std::end(DistanceBase), distance) - std::begin(DistanceBase) - 1;
+    writer.WriteCode(static_cast<uint32_t>(distanceCode), 5);
+    writer.Write(static_cast<uint32_t>(distance - DistanceBase[distanceCode]), DistanceExtra[distanceCode]);
+}
+
+inline uint32_t Hash(const uint8_t* p) {
+    return ((static_cast<uint32_t>(p[0]) << 10) ^ (static_cast<uint32_t>(p[1]) << 5) ^ p[2]) & (HashSize - 1);
+}
+
+
+void Deflate(const uint8_t* data, size_t length, BitWriter& writer) {
+    std::vector<int32_t> head(HashSize, -1);
+    std::vector<int32_t> prev(WindowSize, -1);
+
+    auto insert = [&](size_t pos) {
+        if (length - pos >= MinMatch) {
+            uint32_t h = Hash(data + pos);
+            prev[pos & WindowMask] = head[h];
+            head[h] = static_cast<int32_t>(pos);
+        }
+    };
+
+    size_t pos = 0;
+    while (pos < length) {
+        size_t bestLength = 0;
+        size_t bestDistance = 0;
+
+        if (length - pos >= MinMatch) {
+            size_t maxLength = std::min(MaxMatch, length - pos);
+            int32_t candidate = head[Hash(data + pos)];
+
+            for (size_t chain = 0; candidate >= 0 && chain < MaxChain; chain++) {
+                size_t distance = pos - static_cast<size_t>(candidate);
+                if (distance >= WindowSize) {
+                    break;
+                }
+
+                const uint8_t* match = data + candidate;
+                if (match[bestLength] == data[pos + bestLength]) {
+                    size_t matched = 0;
+                    while (matched < maxLength && match[matched] == data[pos + matched]) {
+                        matched++;
+                    }
+                    if (matched > bestLength) {
+                        bestLength = matched;
+                        bestDistance = distance;
+                        if (matched == maxLength) {
+                            break;
+                        }
+                    }
+                }
+
+                candidate = prev[candidate & WindowMask];
+            }
+        }
+
+        if (bestLength >= MinMatch) {
+            WriteMatch(writer, bestLength, bestDistance);
+            for (size_t i = 0; i < bestLength; i++) {
+                insert(pos + i);
+            }
+            pos += bestLength;
+        } else {
+            WriteSymbol(writer, data[pos]);
+            insert(pos);
+            pos++;
+        }
+    }
+}
+
+void AppendLittleEndian(std::vector<uint8_t>& out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+}
+
+uint32_t Crc32(const void* data, size_t length, uint32_t crc) {
+    const auto& table = CrcTable();
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void GzipCompress(const void* data, size_t length, std::vector<uint8_t>& out) {
+    static const uint8_t header[10] = { 0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 0, 0x0B };
+    out.insert(out.end(), std::begin(header), std::end(header));
+
+
+    BitWriter writer(out);
+    writer.Write(1, 1);
+    writer.Write(1, 2);
+    Deflate(static_cast<const uint8_t*>(data), length, writer);
+    WriteSymbol(writer, EndOfBlock);
+    writer.Finish();
+
+    AppendLittleEndian(out, Crc32(data, length));
+    AppendLittleEndian(out, static_cast<uint32_t>(length));
+}
+
+}
+}
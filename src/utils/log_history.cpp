@@ -0,0 +1,93 @@
+#include "utils/log_history.h"
+#include <algorithm>
+#include <cstring>
+
+namespace xordll {
+
+LogHistory::LogHistory(size_t capacity)
+    : m_arenaHead(0)
+    , m_first(1)
+    , m_next(1)
+{
+    Reset(capacity);
+}
+
+void LogHistory::Reset(size_t capacity) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    capacity = std::max<size_t>(capacity, 1);
+    m_slots.assign(capacity, Slot{});
+    m_arena.assign(capacity * AverageMessageLength, L'\0');
+    m_arenaHead = 0;
+    m_first = m_next;
+}
+
+void LogHistory::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_arenaHead = 0;
+    m_first = m_next;
+}
+
+uint64_t LogHistory::Append(
+    LogLevel level,
+    std::chrono::system_clock::time_point timestamp,
+    uint32_t threadId,
+    std::wstring_view message
+) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const uint64_t arenaSize = m_arena.size();
+    size_t length = std::min<size_t>(message.size(), m_arena.size() / 4);
+
+     
+    uint64_t start = m_arenaHead;
+    if ((start % arenaSize) + length > arenaSize) {
+        start += arenaSize - (start % arenaSize);
+    }
+    m_arenaHead = start + length;
+
+     
+    if (m_next - m_first == m_slots.size()) {
+        m_first++;
+    }
+    while (m_first < m_next && m_slots[m_first % m_slots.size()].start + arenaSize < m_arenaHead) {
+        m_first++;
+    }
+
+    if (length) {
+        std::memcpy(m_arena.data() + (start % arenaSize), message.data(), length * sizeof(wchar_t));
+    }
+
+    uint64_t sequence = m_next++;
+    Slot& slot = m_slots[sequence % m_slots.size()];
+    slot.level = level;
+    slot.timestamp = timestamp;
+    slot.start = start;
+    slot.length = static_cast<uint32_t>(length);
+    slot.threadId = threadId;
+    return sequence;
+}
+
+LogRecordView LogHistory::ViewOf(uint64_t sequence) const {
+    const Slot& slot = m_slots[sequence % m_slots.size()];
+
+    LogRecordView view;
+    view.sequence = sequence;
+    view.level = slot.level;
+    view.timestamp = slot.timestamp;
+    view.threadId = slot.threadId;
+    view.message = std::wstring_view(m_arena.data() + (slot.start % m_arena.size()), slot.length);
+    return view;
+}
+
+uint64_t LogHistory::LastSequence() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_next - 1;
+}
+
+size_t LogHistory::Size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<size_t>(m_next - m_first);
+}
+
+}
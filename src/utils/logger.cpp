@@ -3,12 +3,228 @@
 #include "utils/logger.h"
 #include "utils/string_utils.h"
 #include "utils/file_utils.h"
+#include "utils/binary_log.h"
+#include "utils/gzip.h"
+#include "utils/mapped_file.h"
 #include <iomanip>
 #include <sstream>
 #include <ctime>
+#include <algorithm>
+#include <string_view>
 
 namespace xordll {
 
+namespace {
+
+constexpr size_t QueueCapacity = 8192;
+constexpr size_t MaxBatchSize = 256;
+constexpr std::chrono::milliseconds FlushInterval(200);
+constexpr std::chrono::minutes RotationRetryInterval(1);
+
+constexpr std::wstring_view ArchiveExtension = L".old";
+constexpr std::wstring_view CompressedExtension = L".old.gz";
+constexpr std::wstring_view PartialExtension = L".old.gz.tmp";
+
+const char* LevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug:   return "DEBUG";
+        case LogLevel::Info:    return "INFO";
+        case LogLevel::Warning: return "WARNING";
+        case LogLevel::Error:   return "ERROR";
+        default:                return "UNKNOWN";
+    }
+}
+
+bool StartsWithBinaryHeader(const std::wstring& path) {
+    std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+    char header[utils::BinaryLog::FileHeaderSize];
+    if (!file.read(header, sizeof(header))) {
+        return false;
+    }
+    return utils::BinaryLog::HasFileHeader(header, sizeof(header));
+}
+
+bool EndsWith(std::wstring_view value, std::wstring_view suffix) {
+    return value.size() >= suffix.size() && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+std::chrono::system_clock::time_point FileTimeToTimePoint(const FILETIME& fileTime) {
+    using FileTicks = std::chrono::duration<int64_t, std::ratio<1, 10000000>>;
+    constexpr int64_t UnixEpochTicks = 116444736000000000LL;
+    
+    int64_t ticks = static_cast<int64_t>((static_cast<uint64_t>(fileTime.dwHighDateTime) << 32) | fileTime.dwLowDateTime);
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(FileTicks(ticks - UnixEpochTicks)));
+}
+
+FILETIME TimePointToFileTime(std::chrono::system_clock::time_point time) {
+    using FileTicks = std::chrono::duration<int64_t, std::ratio<1, 10000000>>;
+    constexpr int64_t UnixEpochTicks = 116444736000000000LL;
+    
+    uint64_t ticks = static_cast<uint64_t>(
+        std::chrono::duration_cast<FileTicks>(time.time_since_epoch()).count() + UnixEpochTicks);
+    return FILETIME{ static_cast<DWORD>(ticks & 0xFFFFFFFF), static_cast<DWORD>(ticks >> 32) };
+}
+
+std::chrono::system_clock::time_point FileCreationTime(const std::wstring& path) {
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (!GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &attributes)) {
+        return std::chrono::system_clock::now();
+    }
+    return FileTimeToTimePoint(attributes.ftCreationTime);
+}
+
+ 
+void SetFileCreationTime(const std::wstring& path, std::chrono::system_clock::time_point time) {
+    HANDLE hFile = CreateFileW(path.c_str(), FILE_WRITE_ATTRIBUTES,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    
+    FILETIME creation = TimePointToFileTime(time);
+    SetFileTime(hFile, &creation, nullptr, nullptr);
+    CloseHandle(hFile);
+}
+
+ 
+std::wstring SideLogPath(const std::wstring& path) {
+    size_t dot = path.rfind(L'.');
+    size_t slash = path.find_last_of(L"\\/");
+    if (dot == std::wstring::npos || (slash != std::wstring::npos && dot < slash)) {
+        dot = path.size();
+    }
+    
+    std::wstring stem = path.substr(0, dot) + L"." + std::to_wstring(GetCurrentProcessId());
+    std::wstring extension = path.substr(dot);
+    std::wstring side = stem + extension;
+    for (int n = 1; utils::FileExists(side); n++) {
+        side = stem + L"_" + std::to_wstring(n) + extension;
+    }
+    return side;
+}
+
+ 
+bool CompressArchive(const std::wstring& source, const std::wstring& target) {
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (!GetFileAttributesExW(source.c_str(), GetFileExInfoStandard, &attributes)) {
+        return false;
+    }
+    
+    std::vector<uint8_t> compressed;
+    {
+        utils::MappedFile file;
+        if (!file.Open(source)) {
+            return false;
+        }
+        utils::GzipCompress(file.Data(), file.Size(), compressed);
+    }
+    
+    std::wstring partial = target + L".tmp";
+    HANDLE hFile = CreateFileW(partial.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    
+    bool written = true;
+    size_t offset = 0;
+    while (written && offset < compressed.size()) {
+        DWORD chunk = static_cast<DWORD>(std::min<size_t>(compressed.size() - offset, 1 << 20));
+        DWORD count = 0;
+        written = WriteFile(hFile, compressed.data() + offset, chunk, &count, nullptr) && count == chunk;
+        offset += count;
+    }
+    
+     
+    SetFileTime(hFile, nullptr, nullptr, &attributes.ftLastWriteTime);
+    CloseHandle(hFile);
+    
+    if (!written || !MoveFileExW(partial.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+        DeleteFileW(partial.c_str());
+        return false;
+    }
+    
+    DeleteFileW(source.c_str());
+    return true;
+}
+
+struct ArchiveFile {
+    std::wstring path;
+    std::wstring stem;
+    std::chrono::system_clock::time_point lastWrite;
+    bool compressed;
+};
+
+ 
+void SweepArchives(const std::wstring& logFilePath, const LogRotationPolicy& policy) {
+    std::wstring directory = utils::GetDirectory(logFilePath);
+    std::wstring prefix = utils::GetFileName(logFilePath) + L".";
+    std::vector<ArchiveFile> archives;
+    
+    WIN32_FIND_DATAW findData;
+    HANDLE hFind = FindFirstFileW((logFilePath + L".*").c_str(), &findData);
+    if (hFind == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    
+    do {
+        std::wstring name = findData.cFileName;
+        if ((findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) || name.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+        
+        ArchiveFile archive;
+        archive.path = directory.empty() ? name : directory + L"\\" + name;
+        archive.lastWrite = FileTimeToTimePoint(findData.ftLastWriteTime);
+        
+        if (EndsWith(name, PartialExtension)) {
+            DeleteFileW(archive.path.c_str());
+            continue;
+        } else if (EndsWith(name, CompressedExtension)) {
+            archive.compressed = true;
+            archive.stem = name.substr(0, name.size() - CompressedExtension.size());
+        } else if (EndsWith(name, ArchiveExtension)) {
+            archive.compressed = false;
+            archive.stem = name.substr(0, name.size() - ArchiveExtension.size());
+        } else {
+            continue;
+        }
+        
+        archives.push_back(std::move(archive));
+    } while (FindNextFileW(hFind, &findData));
+    
+    FindClose(hFind);
+    
+     
+    std::sort(archives.begin(), archives.end(), [](const ArchiveFile& a, const ArchiveFile& b) {
+        return a.stem != b.stem ? a.stem > b.stem : a.compressed > b.compressed;
+    });
+    
+    auto now = std::chrono::system_clock::now();
+    size_t kept = 0;
+    
+    for (size_t i = 0; i < archives.size(); i++) {
+        const ArchiveFile& archive = archives[i];
+        
+         
+        bool duplicate = i > 0 && archives[i - 1].stem == archive.stem;
+        bool overCount = policy.maxArchives > 0 && kept >= policy.maxArchives;
+        bool expired = policy.maxArchiveAge.count() > 0 && now - archive.lastWrite > policy.maxArchiveAge;
+        
+        if (duplicate || overCount || expired) {
+            DeleteFileW(archive.path.c_str());
+            continue;
+        }
+        
+        kept++;
+        if (policy.compressArchives && !archive.compressed) {
+            CompressArchive(archive.path, archive.path + L".gz");
+        }
+    }
+}
+
+}
+
 Logger& Logger::Instance()
 {
     static Logger instance;
@@ -16,53 +232,97 @@ Logger& Logger::Instance()
 }
 
 Logger::Logger()
-    : m_maxFileSize(5 * 1024 * 1024)
-    , m_currentFileSize(0)
+    : m_currentFileSize(0)
+    , m_fileFormat(LogFileFormat::Text)
     , m_minLevel(LogLevel::Debug)
-    , m_uiCallback(nullptr)
+    , m_queue(QueueCapacity)
+    , m_overflowPolicy(LogOverflowPolicy::Drop)
+    , m_dropped(0)
+    , m_droppedTotal(0)
+    , m_writerIdle(false)
+    , m_stopping(false)
+    , m_flushRequested(false)
+    , m_flushedPosition(0)
+    , m_archiveRequested(false)
+    , m_archiveStopping(false)
     , m_initialized(false)
 {
+    m_writer = std::thread(&Logger::WriterThread, this);
 }
 
 Logger::~Logger()
 {
     Shutdown();
-}
-
-bool Logger::Initialize(const std::wstring& logFilePath, size_t maxFileSize)
-{
-    std::lock_guard<std::mutex> lock(m_mutex);
     
-    if (m_initialized) {
-        return true;
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stopping = true;
     }
+    m_wakeCondition.notify_all();
     
-    m_maxFileSize = maxFileSize;
-    
-     
-    if (logFilePath.empty()) {
-        m_logFilePath = GetDefaultLogPath();
-    } else {
-        m_logFilePath = logFilePath;
+    if (m_writer.joinable()) {
+        m_writer.join();
     }
     
      
-    std::wstring dir = utils::GetDirectory(m_logFilePath);
-    if (!dir.empty()) {
-        utils::CreateDirectoryRecursive(dir);
+    {
+        std::lock_guard<std::mutex> lock(m_archiveMutex);
+        m_archiveStopping = true;
     }
+    m_archiveCondition.notify_all();
     
-     
-    m_logFile.open(m_logFilePath.c_str(), std::ios::app | std::ios::out);
-    if (!m_logFile.is_open()) {
-        return false;
+    if (m_archiver.joinable()) {
+        m_archiver.join();
+    }
+}
+
+bool Logger::Initialize(const std::wstring& logFilePath, size_t maxFileSize, LogFileFormat format)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_fileMutex);
+        
+        if (m_initialized) {
+            return true;
+        }
+        
+        m_rotation.maxFileSize = maxFileSize;
+        m_fileFormat = format;
+        
+         
+        if (logFilePath.empty()) {
+            m_logFilePath = GetDefaultLogPath();
+        } else {
+            m_logFilePath = logFilePath;
+        }
+        
+         
+        std::wstring dir = utils::GetDirectory(m_logFilePath);
+        if (!dir.empty()) {
+            utils::CreateDirectoryRecursive(dir);
+        }
+        
+         
+        bool existingData = utils::GetFileSize(m_logFilePath) > 0;
+        bool existingBinary = StartsWithBinaryHeader(m_logFilePath);
+        if (existingData && existingBinary != (format == LogFileFormat::Binary) &&
+            !ArchiveLogFile(std::chrono::system_clock::now())) {
+            m_logFilePath = SideLogPath(m_logFilePath);
+        }
+        
+        if (!OpenLogFile(false)) {
+            return false;
+        }
+        
+         
+        if (m_currentFileSize > utils::BinaryLog::FileHeaderSize) {
+            m_segmentStart = FileCreationTime(m_logFilePath);
+        }
+        
+        m_initialized = true;
     }
     
      
-    m_logFile.seekp(0, std::ios::end);
-    m_currentFileSize = static_cast<size_t>(m_logFile.tellp());
-    
-    m_initialized = true;
+    RequestArchiveSweep();
     
      
     Log(LogLevel::Info, L"=== Logger initialized ===");
@@ -72,60 +332,184 @@ bool Logger::Initialize(const std::wstring& logFilePath, size_t maxFileSize)
 
 void Logger::Shutdown()
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    
     if (!m_initialized) {
         return;
     }
     
-    if (m_logFile.is_open()) {
-        m_logFile << L"=== Logger shutdown ===" << std::endl;
-        m_logFile.close();
+     
+    Flush();
+    
+    {
+        std::lock_guard<std::mutex> lock(m_fileMutex);
+        
+        if (m_logFile.is_open()) {
+            std::string line;
+            AppendEntry(line, m_fileFormat, m_formatState, LogLevel::Info, std::chrono::system_clock::now(),
+                GetCurrentThreadId(), L"=== Logger shutdown ===");
+            m_logFile.write(line.data(), static_cast<std::streamsize>(line.size()));
+            m_logFile.close();
+        }
+        
+        m_initialized = false;
     }
     
-    m_entries.clear();
-    m_initialized = false;
+    m_history.Clear();
 }
 
 void Logger::SetMinLevel(LogLevel level)
 {
-    m_minLevel = level;
+    m_minLevel.store(level, std::memory_order_relaxed);
+}
+
+void Logger::SetRotationPolicy(const LogRotationPolicy& policy)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_fileMutex);
+        m_rotation = policy;
+    }
+    
+    if (m_initialized) {
+        RequestArchiveSweep();
+    }
 }
 
 void Logger::SetUICallback(LogCallback callback)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_uiCallback = callback;
+    std::shared_ptr<const LogCallback> shared;
+    if (callback) {
+        shared = std::make_shared<const LogCallback>(std::move(callback));
+    }
+    std::atomic_store(&m_uiCallback, shared);
 }
 
 void Logger::Log(LogLevel level, const std::wstring& message)
 {
-    if (level < m_minLevel) {
+    if (!IsEnabled(level)) {
         return;
     }
     
-    LogEntry entry(level, message);
+     
+    std::shared_ptr<const LogCallback> callback = std::atomic_load(&m_uiCallback);
+    if (callback) {
+        (*callback)(level, message);
+    }
     
-    {
-        std::lock_guard<std::mutex> lock(m_mutex);
+    Enqueue(LogEntry(level, message));
+}
+
+void Logger::Enqueue(LogEntry&& entry)
+{
+     
+    bool block = m_overflowPolicy == LogOverflowPolicy::Block || entry.level == LogLevel::Error;
+    
+    while (!m_queue.TryPush(std::move(entry))) {
+        if (!block || m_stopping) {
+            m_dropped++;
+            m_droppedTotal++;
+            return;
+        }
+        WakeWriter();
+        std::this_thread::yield();
+    }
+    
+    WakeWriter();
+}
+
+void Logger::WakeWriter()
+{
+     
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_writerIdle.load()) {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_wakeCondition.notify_one();
+    }
+}
+
+void Logger::Flush()
+{
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    if (m_stopping) {
+        return;
+    }
+    
+    size_t target = m_queue.Reserved();
+    m_flushRequested = true;
+    m_wakeCondition.notify_one();
+    
+    m_flushCondition.wait(lock, [this, target]() {
+        return m_flushedPosition >= target || m_stopping;
+    });
+}
+
+void Logger::WriterThread()
+{
+    LogEntry entry;
+    std::vector<LogEntry> batch;
+    batch.reserve(MaxBatchSize + 1);
+    auto lastFlush = std::chrono::steady_clock::now();
+    
+    for (;;) {
+        size_t drained = 0;
+        batch.clear();
         
-         
-        m_entries.push_back(entry);
+        while (drained < MaxBatchSize && m_queue.TryPop(entry)) {
+            drained++;
+            m_history.Append(entry.level, entry.timestamp, entry.threadId, entry.message);
+            batch.push_back(std::move(entry));
+        }
         
-         
-        while (m_entries.size() > 1000) {
-            m_entries.erase(m_entries.begin());
+        uint64_t dropped = m_dropped.exchange(0);
+        if (dropped) {
+            batch.emplace_back(LogLevel::Warning, std::to_wstring(dropped) + L" log entries dropped (queue full)");
         }
         
-         
-        if (m_initialized) {
-            WriteToFile(entry);
+        bool flushRequested;
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            flushRequested = m_flushRequested;
+        }
+        
+        auto now = std::chrono::steady_clock::now();
+        bool flushDue = flushRequested || m_stopping || now - lastFlush >= FlushInterval;
+        size_t consumed = m_queue.Consumed();
+        
+        {
+            std::lock_guard<std::mutex> lock(m_fileMutex);
+            if (!batch.empty() && m_initialized) {
+                WriteEntries(batch);
+            }
+            if (flushDue && m_logFile.is_open()) {
+                m_logFile.flush();
+            }
         }
         
+        if (drained == MaxBatchSize) {
+            continue;
+        }
+        
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        
          
-        if (m_uiCallback) {
-            m_uiCallback(level, message);
+        if (flushDue) {
+            lastFlush = now;
+            m_flushedPosition = consumed;
+            if (m_queue.Empty()) {
+                m_flushRequested = false;
+            }
+            m_flushCondition.notify_all();
+        }
+        
+        if (m_stopping && m_queue.Empty()) {
+            m_flushCondition.notify_all();
+            return;
         }
+        
+        m_writerIdle = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        m_wakeCondition.wait_for(lock, FlushInterval, [this]() {
+            return m_stopping || m_flushRequested || !m_queue.Empty();
+        });
+        m_writerIdle = false;
     }
 }
 
@@ -152,43 +536,53 @@ void Logger::Error(const std::wstring& message)
 void Logger::LogWindowsError(const std::wstring& operation)
 {
     DWORD error = GetLastError();
+    if (!IsEnabled(LogLevel::Error)) {
+        return;
+    }
+    
     std::wstring message = operation + L": " + utils::FormatWindowsError(error);
     Log(LogLevel::Error, message);
 }
 
 std::vector<LogEntry> Logger::GetRecentEntries(size_t count) const
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<LogEntry> result;
+    result.reserve(std::min(count, m_history.Size()));
     
-    if (count >= m_entries.size()) {
-        return m_entries;
-    }
+    m_history.ReadRecent(count, [&result](const LogRecordView& view) {
+        LogEntry entry(view.level, std::wstring(view.message));
+        entry.timestamp = view.timestamp;
+        entry.threadId = view.threadId;
+        result.push_back(std::move(entry));
+    });
     
-    return std::vector<LogEntry>(
-        m_entries.end() - static_cast<ptrdiff_t>(count),
-        m_entries.end()
-    );
+    return result;
+}
+
+void Logger::SetHistoryCapacity(size_t entries)
+{
+    m_history.Reset(entries);
 }
 
 void Logger::ClearEntries()
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_entries.clear();
+    m_history.Clear();
 }
 
 bool Logger::ExportToFile(const std::wstring& filePath) const
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    
-    std::wofstream file(filePath.c_str(), std::ios::out | std::ios::trunc);
+    std::ofstream file(filePath.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
     if (!file.is_open()) {
         return false;
     }
     
-    for (const auto& entry : m_entries) {
-        file << FormatEntry(entry) << std::endl;
-    }
+    std::string text;
+    FormatState state;
+    m_history.Read(0, SIZE_MAX, [&text, &state](const LogRecordView& view) {
+        AppendEntry(text, LogFileFormat::Text, state, view.level, view.timestamp, 0, view.message);
+    });
     
+    file.write(text.data(), static_cast<std::streamsize>(text.size()));
     file.close();
     return true;
 }
@@ -215,61 +609,198 @@ COLORREF Logger::LevelToColor(LogLevel level)
     }
 }
 
-void Logger::WriteToFile(const LogEntry& entry)
+void Logger::AppendEntry(
+    std::string& out,
+    LogFileFormat format,
+    FormatState& state,
+    LogLevel level,
+    std::chrono::system_clock::time_point timestamp,
+    DWORD threadId,
+    std::wstring_view message
+)
 {
-    if (!m_logFile.is_open()) {
+    if (format == LogFileFormat::Binary) {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+        state.binary.Append(out, static_cast<uint64_t>(ns), threadId, static_cast<uint8_t>(level), message);
         return;
     }
     
      
-    if (m_currentFileSize >= m_maxFileSize) {
+    std::time_t second = std::chrono::system_clock::to_time_t(timestamp);
+    if (second != state.second) {
+        std::tm tm;
+        localtime_s(&tm, &second);
+        state.length = std::strftime(state.text, sizeof(state.text), "[%Y-%m-%d %H:%M:%S] ", &tm);
+        state.second = second;
+    }
+    
+    out.append(state.text, state.length);
+    out += '[';
+    out += LevelName(level);
+    out += "] ";
+    utils::BinaryLog::AppendUtf8(out, message);
+    out += "\r\n";
+}
+
+bool Logger::OpenLogFile(bool truncate)
+{
+    m_logFile.open(m_logFilePath.c_str(),
+        std::ios::out | std::ios::binary | (truncate ? std::ios::trunc : std::ios::app));
+    if (!m_logFile.is_open()) {
+        m_currentFileSize = 0;
+        return false;
+    }
+    
+    m_logFile.seekp(0, std::ios::end);
+    m_currentFileSize = static_cast<size_t>(m_logFile.tellp());
+    m_segmentStart = std::chrono::system_clock::now();
+    m_formatState = FormatState();
+    
+    if (m_currentFileSize == 0) {
+        SetFileCreationTime(m_logFilePath, m_segmentStart);
+    }
+    
+    if (m_currentFileSize == 0 && m_fileFormat == LogFileFormat::Binary) {
+        std::string header;
+        utils::BinaryLog::AppendFileHeader(header);
+        m_logFile.write(header.data(), static_cast<std::streamsize>(header.size()));
+        m_currentFileSize = header.size();
+    }
+    
+    return true;
+}
+
+bool Logger::RotationDue(size_t incoming) const
+{
+    if (m_currentFileSize <= utils::BinaryLog::FileHeaderSize) {
+        return false;
+    }
+    
+    auto now = std::chrono::system_clock::now();
+    bool full = m_currentFileSize + incoming > m_rotation.maxFileSize;
+    bool expired = m_rotation.maxFileAge.count() > 0 && now - m_segmentStart >= m_rotation.maxFileAge;
+    return (full || expired) && now >= m_rotationRetryAt;
+}
+
+void Logger::WriteEntries(const std::vector<LogEntry>& entries)
+{
+    if (!m_logFile.is_open()) {
+        return;
+    }
+    
+    auto encode = [this, &entries]() {
+        m_batch.clear();
+        for (const auto& entry : entries) {
+            AppendEntry(m_batch, m_fileFormat, m_formatState, entry.level, entry.timestamp, entry.threadId,
+                entry.message);
+        }
+    };
+    
+    encode();
+    if (RotationDue(m_batch.size())) {
         RotateLogFile();
+        if (!m_logFile.is_open()) {
+            return;
+        }
+        encode();
     }
     
-    std::wstring formatted = FormatEntry(entry);
-    m_logFile << formatted << std::endl;
-    m_logFile.flush();
+    WriteToFile(m_batch);
+}
+
+void Logger::WriteToFile(const std::string& data)
+{
+    if (!m_logFile.is_open()) {
+        return;
+    }
     
-    m_currentFileSize += (formatted.length() + 1) * sizeof(wchar_t);
+    m_logFile.write(data.data(), static_cast<std::streamsize>(data.size()));
+    m_currentFileSize += data.size();
 }
 
 void Logger::RotateLogFile()
 {
     m_logFile.close();
     
-     
     auto now = std::chrono::system_clock::now();
+    bool moved = ArchiveLogFile(now);
+    if (!OpenLogFile(moved)) {
+        return;
+    }
+    
+    if (!moved) {
+        m_rotationRetryAt = now + RotationRetryInterval;
+        return;
+    }
+    
+    std::string notice;
+    AppendEntry(notice, m_fileFormat, m_formatState, LogLevel::Info, now, GetCurrentThreadId(), L"Log file rotated");
+    WriteToFile(notice);
+    
+    RequestArchiveSweep();
+}
+
+bool Logger::ArchiveLogFile(std::chrono::system_clock::time_point now)
+{
+     
     auto time = std::chrono::system_clock::to_time_t(now);
     std::tm tm;
     localtime_s(&tm, &time);
     
     std::wstringstream ss;
     ss << m_logFilePath << L"."
-       << std::put_time(&tm, L"%Y%m%d_%H%M%S")
-       << L".old";
-    
-    std::wstring oldPath = ss.str();
-    MoveFileW(m_logFilePath.c_str(), oldPath.c_str());
+       << std::put_time(&tm, L"%Y%m%d_%H%M%S");
     
-     
-    m_logFile.open(m_logFilePath.c_str(), std::ios::out | std::ios::trunc);
-    m_currentFileSize = 0;
+    std::wstring stem = ss.str();
+    std::wstring oldPath = stem + std::wstring(ArchiveExtension);
+    for (int n = 1; utils::FileExists(oldPath) || utils::FileExists(oldPath + L".gz"); n++) {
+        oldPath = stem + L"_" + std::to_wstring(n) + std::wstring(ArchiveExtension);
+    }
     
-    Log(LogLevel::Info, L"Log file rotated");
+    return MoveFileW(m_logFilePath.c_str(), oldPath.c_str()) != FALSE;
 }
 
-std::wstring Logger::FormatEntry(const LogEntry& entry) const
+void Logger::RequestArchiveSweep()
 {
-    auto time = std::chrono::system_clock::to_time_t(entry.timestamp);
-    std::tm tm;
-    localtime_s(&tm, &time);
-    
-    std::wstringstream ss;
-    ss << std::put_time(&tm, L"[%Y-%m-%d %H:%M:%S] ")
-       << L"[" << LevelToString(entry.level) << L"] "
-       << entry.message;
+    {
+        std::lock_guard<std::mutex> lock(m_archiveMutex);
+        if (m_archiveStopping) {
+            return;
+        }
+        
+        m_archiveRequested = true;
+        if (!m_archiver.joinable()) {
+            m_archiver = std::thread(&Logger::ArchiveThread, this);
+        }
+    }
     
-    return ss.str();
+    m_archiveCondition.notify_one();
+}
+
+void Logger::ArchiveThread()
+{
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_archiveMutex);
+            m_archiveCondition.wait(lock, [this]() { return m_archiveRequested || m_archiveStopping; });
+            if (!m_archiveRequested) {
+                return;
+            }
+            m_archiveRequested = false;
+        }
+        
+        std::wstring logFilePath;
+        LogRotationPolicy policy;
+        {
+            std::lock_guard<std::mutex> lock(m_fileMutex);
+            logFilePath = m_logFilePath;
+            policy = m_rotation;
+        }
+        
+        if (!logFilePath.empty()) {
+            SweepArchives(logFilePath, policy);
+        }
+    }
 }
 
 std::wstring Logger::GetDefaultLogPath() const
@@ -0,0 +1,196 @@
+#include "utils/mapped_file.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace xordll {
+namespace utils {
+
+MappedFile::MappedFile()
+    : m_data(nullptr)
+    , m_size(0)
+    , m_open(false)
+#ifdef _WIN32
+    , m_file(nullptr)
+    , m_mapping(nullptr)
+#endif
+{
+}
+
+MappedFile::MappedFile(const PathType& path)
+    : MappedFile()
+{
+    Open(path);
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : MappedFile()
+{
+    MoveFrom(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        Close();
+        MoveFrom(other);
+    }
+    return *this;
+}
+
+void MappedFile::MoveFrom(MappedFile& other)
+{
+    m_data = other.m_data;
+    m_size = other.m_size;
+    m_open = other.m_open;
+#ifdef _WIN32
+    m_file = other.m_file;
+    m_mapping = other.m_mapping;
+    other.m_file = nullptr;
+    other.m_mapping = nullptr;
+#endif
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_open = false;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const PathType& path)
+{
+    Close();
+
+    HANDLE hFile = CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+
+    if (hFile == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(hFile, &fileSize)) {
+        CloseHandle(hFile);
+        return false;
+    }
+
+    m_file = hFile;
+    m_open = true;
+
+
+    if (fileSize.QuadPart == 0) {
+        return true;
+    }
+
+    if (static_cast<ULONGLONG>(fileSize.QuadPart) > static_cast<ULONGLONG>(SIZE_MAX)) {
+        Close();
+        SetLastError(ERROR_NOT_ENOUGH_MEMORY);
+        return false;
+    }
+
+    HANDLE hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!hMapping) {
+        Close();
+        return false;
+    }
+    m_mapping = hMapping;
+
+    LPVOID view = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        Close();
+        return false;
+    }
+
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mapping) {
+        CloseHandle(m_mapping);
+    }
+    if (m_file) {
+        CloseHandle(m_file);
+    }
+
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+    m_mapping = nullptr;
+    m_file = nullptr;
+}
+
+#else
+
+bool MappedFile::Open(const PathType& path)
+{
+    Close();
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+
+    m_open = true;
+
+    if (st.st_size == 0) {
+        ::close(fd);
+        return true;
+    }
+
+    void* view = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if (view == MAP_FAILED) {
+        m_open = false;
+        return false;
+    }
+
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(st.st_size);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data) {
+        ::munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+}
+
+#endif
+
+}
+}
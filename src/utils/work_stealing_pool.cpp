@@ -0,0 +1,131 @@
+#include "utils/work_stealing_pool.h"
+#include <algorithm>
+
+namespace xordll {
+namespace utils {
+
+WorkStealingPool::WorkStealingPool(size_t threadCount)
+    : m_nextQueue(0)
+    , m_queued(0)
+    , m_outstanding(0)
+    , m_stopping(false)
+{
+    if (threadCount == 0) {
+        threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    m_queues.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++) {
+        m_queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    m_workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++) {
+        m_workers.emplace_back(&WorkStealingPool::WorkerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    Wait();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+
+    m_workAvailable.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void WorkStealingPool::Submit(Task task) {
+    if (!task) {
+        return;
+    }
+
+    size_t index = m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_outstanding++;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+        m_queues[index]->tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queued++;
+    }
+    m_workAvailable.notify_one();
+}
+
+void WorkStealingPool::Wait() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_outstanding == 0; });
+}
+
+bool WorkStealingPool::PopLocal(size_t index, Task& task) {
+    WorkQueue& queue = *m_queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::Steal(size_t thief, Task& task) {
+    size_t count = m_queues.size();
+    for (size_t offset = 1; offset < count; offset++) {
+        WorkQueue& victim = *m_queues[(thief + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::Finish() {
+    bool idle;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        idle = (--m_outstanding == 0);
+    }
+
+    if (idle) {
+        m_idle.notify_all();
+    }
+}
+
+void WorkStealingPool::WorkerLoop(size_t index) {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workAvailable.wait(lock, [this] { return m_stopping || m_queued > 0; });
+            if (m_queued == 0) {
+                return;
+            }
+            m_queued--;
+        }
+
+        Task task;
+        while (!PopLocal(index, task) && !Steal(index, task)) {
+            std::this_thread::yield();
+        }
+
+        task();
+        Finish();
+    }
+}
+
+}
+}